@@ -0,0 +1,67 @@
+#
+# Created by Kyrylo Rud on 19.10.2026.
+#
+
+# Invoked as a script by the custom command below: turns EMBED_INPUT into a header defining EMBED_SYMBOL.
+if(CMAKE_SCRIPT_MODE_FILE)
+   file(READ "${EMBED_INPUT}" CONTENT HEX)
+   string(LENGTH "${CONTENT}" HEX_LENGTH)
+   math(EXPR SIZE "${HEX_LENGTH} / 2")
+   # Eight bytes per line.
+   string(REPEAT "[0-9a-f]" 16 LINE_PATTERN)
+   string(REGEX REPLACE "(${LINE_PATTERN})" "\\1\n" LINES "${CONTENT}")
+   string(REGEX REPLACE "([0-9a-f][0-9a-f])" "std::byte{0x\\1}, " BYTES "${LINES}")
+   string(REGEX REPLACE " ?\n" "\n   " BYTES "${BYTES}")
+   string(REGEX REPLACE "[ \n]+$" "" BYTES "${BYTES}")
+   get_filename_component(INPUT_NAME "${EMBED_INPUT}" NAME)
+
+   file(WRITE "${EMBED_OUTPUT}.tmp"
+      "//\n"
+      "// Generated by embed_rom from ${INPUT_NAME}, do not edit.\n"
+      "//\n"
+      "\n"
+      "#pragma once\n"
+      "\n"
+      "#include <array>\n"
+      "#include <cstddef>\n"
+      "\n"
+      "namespace erelic::embedded {\n"
+      "inline constexpr auto ${EMBED_SYMBOL} = std::array<std::byte, ${SIZE}>{\n"
+      "   ${BYTES}\n"
+      "};\n"
+      "}; // namespace erelic::embedded\n"
+   )
+   file(COPY_FILE "${EMBED_OUTPUT}.tmp" "${EMBED_OUTPUT}" ONLY_IF_DIFFERENT)
+   file(REMOVE "${EMBED_OUTPUT}.tmp")
+   return()
+endif()
+
+set(EMBED_ROM_SCRIPT "${CMAKE_CURRENT_LIST_FILE}")
+
+# Embeds a binary file into a target as `erelic::embedded::<SYMBOL>`, a `constexpr std::array<std::byte, N>` declared
+# in the generated header `<SYMBOL>.hpp`. The header is regenerated at build time whenever the file changes.
+# Usage: embed_rom(TARGET target SYMBOL name FILE "/path/to/image.bin")
+function(embed_rom)
+   set(ONE_VALUE_ARGS TARGET SYMBOL FILE)
+
+   cmake_parse_arguments(PARSE_ARGV 0 ARG "" "${ONE_VALUE_ARGS}" "")
+
+   if(NOT ARG_TARGET OR NOT ARG_SYMBOL OR NOT ARG_FILE)
+      message(FATAL_ERROR "embed_rom: TARGET, SYMBOL and FILE arguments are required")
+   endif()
+
+   get_filename_component(INPUT "${ARG_FILE}" ABSOLUTE)
+   set(OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/embedded")
+   set(OUTPUT "${OUTPUT_DIR}/${ARG_SYMBOL}.hpp")
+
+   add_custom_command(
+      OUTPUT "${OUTPUT}"
+      COMMAND ${CMAKE_COMMAND} -DEMBED_INPUT=${INPUT} -DEMBED_OUTPUT=${OUTPUT} -DEMBED_SYMBOL=${ARG_SYMBOL}
+              -P ${EMBED_ROM_SCRIPT}
+      DEPENDS "${INPUT}" "${EMBED_ROM_SCRIPT}"
+      COMMENT "Embedding ${ARG_FILE} as ${ARG_SYMBOL}"
+      VERBATIM
+   )
+   target_sources(${ARG_TARGET} PRIVATE "${OUTPUT}")
+   target_include_directories(${ARG_TARGET} PRIVATE "${OUTPUT_DIR}")
+endfunction()
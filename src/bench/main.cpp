@@ -0,0 +1,319 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+#include "instruction.hpp"
+#include "micro_ops.hpp"
+#include "perf_counters.hpp"
+#include "registers.hpp"
+#include "runahead.hpp"
+
+using namespace erelic;
+using namespace erelic::bench;
+
+namespace {
+struct ram {
+  std::array<std::byte, 0x8000> cells{};
+
+  [[nodiscard]] auto read(address /*unused*/, address r) const noexcept -> std::byte { return cells[r.raw]; }
+  [[nodiscard]] auto write(address /*unused*/, address r, std::byte v) noexcept -> write_status {
+    cells[r.raw] = v;
+    return write_status::WRITTEN;
+  }
+};
+
+struct rom {
+  [[nodiscard]] static auto read(address /*unused*/, address r) noexcept -> std::byte {
+    return std::byte{static_cast<unsigned char>(r.raw)};
+  }
+  [[nodiscard]] static auto write(address /*unused*/, address /*unused*/, std::byte /*unused*/) noexcept
+    -> write_status {
+    return write_status::IGNORED;
+  }
+};
+
+// Semantics-free core: the micro-op benchmark measures sequencing and bus traffic only.
+struct passive_core {
+  [[nodiscard]] static auto execute(const instruction & /*unused*/, std::byte value, address /*unused*/) noexcept
+    -> std::byte {
+    return value;
+  }
+  [[nodiscard]] static auto taken(const instruction & /*unused*/, std::byte value) noexcept -> bool {
+    return (std::to_integer<unsigned>(value) & 1U) != 0;
+  }
+};
+
+// Synthetic machine for the run-ahead benchmarks: a frame of pseudo-random read-modify-writes over 64K of RAM,
+// snapshotted as one region plus two registers. A presented frame also renders a 320x200 hires bitmap into host
+// pixels, as a video chip would, about a third of its time on a debug build; hidden frames skip it, as
+// `frame_machine` allows.
+struct frame_machine_model {
+  static constexpr std::uint64_t frame_cycles = 150'000;
+  static constexpr std::size_t bitmap = 0x2000;
+  static constexpr std::size_t screen = 0x0400;
+  static constexpr std::size_t width = 320;
+  static constexpr std::size_t height = 200;
+
+  std::vector<std::byte> ram = std::vector<std::byte>(address_space_size);
+  std::uint64_t pc = 0;
+  std::uint64_t acc = 0;
+  std::uint64_t input = 0;
+  std::vector<std::uint32_t> pixels = std::vector<std::uint32_t>(width * height);
+  std::uint64_t shown = 0;
+
+  void run_frame(bool present) {
+    for (std::uint64_t i = 0; i < frame_cycles; ++i) {
+      acc = acc * 33 + std::to_integer<std::uint64_t>(ram[pc]) + input;
+      ram[pc] = static_cast<std::byte>(acc);
+      pc = (pc + 1 + (acc & 0x07U)) & 0xFFFFU;
+    }
+    if (present) {
+      render();
+    }
+  }
+
+  // Each 8x8 cell takes its two colours from the screen RAM byte of the cell, as in the C64 hires mode.
+  void render() {
+    static constexpr auto palette = std::array<std::uint32_t, 16>{
+      0x000000, 0xFFFFFF, 0x880000, 0xAAFFEE, 0xCC44CC, 0x00CC55, 0x0000AA, 0xEEEE77,
+      0xDD8855, 0x664400, 0xFF7777, 0x333333, 0x777777, 0xAAFF66, 0x0088FF, 0xBBBBBB};
+    for (std::size_t y = 0; y < height; ++y) {
+      for (std::size_t column = 0; column < width / 8; ++column) {
+        const auto cell = (y / 8) * (width / 8) + column;
+        const auto bits = std::to_integer<unsigned>(ram[bitmap + cell * 8 + y % 8]);
+        const auto colours = std::to_integer<unsigned>(ram[screen + cell]);
+        auto *out = &pixels[y * width + column * 8];
+        for (unsigned bit = 0; bit < 8; ++bit) {
+          out[bit] = palette[(colours >> (((bits >> (7 - bit)) & 1U) * 4)) & 0x0FU];
+        }
+      }
+    }
+    shown += pixels[(acc % height) * width + acc % width];
+  }
+
+  [[nodiscard]] auto state_regions() -> std::array<std::span<std::byte>, 1> { return {ram}; }
+  void save_register_state(std::ostream &os) const { os << pc << ' ' << acc << ' '; }
+  void load_register_state(std::istream &is) { is >> pc >> acc; }
+};
+
+// Runs `units` cycles in whole frames through `run_ahead`, changing the input every `hold` frames.
+auto run_frames_ahead(std::uint64_t units, std::size_t frames_ahead, std::uint64_t hold) -> std::uint64_t {
+  auto machine = frame_machine_model{};
+  auto ra = run_ahead<frame_machine_model>{frames_ahead, address_space_size + 64};
+  for (std::uint64_t frame = 0; frame < units / frame_machine_model::frame_cycles; ++frame) {
+    const auto changed = frame % hold == 0;
+    machine.input += changed ? 1 : 0;
+    ra.run_frame(machine, changed);
+  }
+  ra.sync(machine);
+  return machine.acc + machine.shown;
+}
+
+// One benchmark: `run` performs `units` units of emulated work (decoded instructions, bus accesses or cycles) and
+// returns a checksum that keeps the work observable. With a `baseline`, the time is also reported relative to that
+// earlier benchmark.
+struct benchmark {
+  std::string_view name;
+  std::string_view unit;
+  std::function<std::uint64_t(std::uint64_t units)> run;
+  std::string_view baseline{};
+};
+
+// Fixed-seed inputs, so every version is measured on the same stream.
+auto random_bytes(std::size_t count) -> std::vector<std::byte> {
+  auto engine = std::mt19937{6502};
+  auto dist = std::uniform_int_distribution<unsigned>{0, 0xFF};
+  auto bytes = std::vector<std::byte>(count);
+  for (auto &b : bytes) {
+    b = std::byte{static_cast<unsigned char>(dist(engine))};
+  }
+  return bytes;
+}
+
+auto random_addresses(std::size_t count) -> std::vector<address> {
+  auto engine = std::mt19937{6510};
+  auto dist = std::uniform_int_distribution<unsigned>{0, 0xFFFF};
+  auto addresses = std::vector<address>{};
+  addresses.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    addresses.emplace_back(static_cast<address_raw>(dist(engine)));
+  }
+  return addresses;
+}
+
+auto make_bus() -> bus {
+  auto b = bus{};
+  b.map(address_range{address{0x0000}, address{0x7FFF}}, device{ram{}});
+  b.map(address_range{address{0xC000}, address{0xFFFF}}, device{rom{}});
+  return b;
+}
+
+auto make_benchmarks() -> std::vector<benchmark> {
+  constexpr auto input_size = std::size_t{4096};
+  auto opcodes = random_bytes(input_size);
+  auto addresses = random_addresses(input_size);
+
+  return {
+    {"decode", "instruction",
+     [opcodes](std::uint64_t units) {
+       const auto &table = instruction_table_for(instruction_set::NMOS);
+       auto sum = std::uint64_t{0};
+       for (std::uint64_t i = 0; i < units; ++i) {
+         sum += as_instruction(opcodes[i % opcodes.size()], table).cycles;
+       }
+       return sum;
+     }},
+    {"device_read", "access",
+     [addresses](std::uint64_t units) {
+       const auto dev = device{ram{}};
+       auto sum = std::uint64_t{0};
+       for (std::uint64_t i = 0; i < units; ++i) {
+         const auto a = addresses[i % addresses.size()];
+         sum += std::to_integer<std::uint64_t>(dev.read(a, address{static_cast<address_raw>(a.raw & 0x7FFFU)}));
+       }
+       return sum;
+     }},
+    {"bus_read", "access",
+     [addresses](std::uint64_t units) {
+       const auto b = make_bus();
+       auto sum = std::uint64_t{0};
+       for (std::uint64_t i = 0; i < units; ++i) {
+         sum += std::to_integer<std::uint64_t>(b.read(addresses[i % addresses.size()]));
+       }
+       return sum;
+     }},
+    {"bus_write", "access",
+     [addresses](std::uint64_t units) {
+       auto b = make_bus();
+       auto sum = std::uint64_t{0};
+       for (std::uint64_t i = 0; i < units; ++i) {
+         sum += static_cast<std::uint64_t>(b.write(addresses[i % addresses.size()], std::byte{0xA5}));
+       }
+       return sum;
+     }},
+    {"micro_ops", "cycle",
+     [](std::uint64_t units) {
+       auto b = make_bus();
+       auto core = passive_core{};
+       auto regs = registers{.pc = address{0xC000}};
+       auto engine = micro_engine{b, core, regs, instruction_set::STND};
+       auto sum = std::uint64_t{0};
+       for (std::uint64_t i = 0; i < units; ++i) {
+         sum += engine.tick() ? 1 : 0;
+       }
+       return sum;
+     }},
+    {"frame", "cycle", [](std::uint64_t units) { return run_frames_ahead(units, 0, 1); }},
+    {"runahead_2", "cycle", [](std::uint64_t units) { return run_frames_ahead(units, 2, 1); }, "frame"},
+    {"runahead_2_held", "cycle", [](std::uint64_t units) { return run_frames_ahead(units, 2, 30); }, "frame"},
+  };
+}
+
+struct options {
+  bool perf = false;
+  std::uint64_t units = 10'000'000;
+};
+
+auto parse(std::span<char *> args) -> std::optional<options> {
+  auto opts = options{};
+  for (std::size_t i = 1; i < args.size(); ++i) {
+    const auto arg = std::string_view{args[i]};
+    if (arg == "--perf") {
+      opts.perf = true;
+    } else if (arg == "--units" && i + 1 < args.size()) {
+      auto is = std::istringstream{args[++i]};
+      if (!(is >> opts.units) || opts.units == 0) {
+        return std::nullopt;
+      }
+    } else {
+      return std::nullopt;
+    }
+  }
+  return opts;
+}
+
+void report(const benchmark &bench, std::uint64_t units, std::chrono::nanoseconds elapsed, std::uint64_t checksum,
+            const std::optional<perf_sample> &sample, std::optional<std::chrono::nanoseconds> baseline) {
+  auto out = std::ostreambuf_iterator(std::cout);
+  out = std::format_to(out, "{:<16} {:>8.3f} ns/{}", bench.name,
+                       static_cast<double>(elapsed.count()) / static_cast<double>(units), bench.unit);
+  if (baseline && baseline->count() > 0) {
+    out = std::format_to(out, "  {:>5.2f}x {}", static_cast<double>(elapsed.count()) /
+                                                  static_cast<double>(baseline->count()), bench.baseline);
+  }
+  if (sample) {
+    for (const auto e : perf_events) {
+      auto os = std::ostringstream{};
+      os << e;
+      if (const auto value = sample->per(e, units)) {
+        out = std::format_to(out, "  {} {:>8.4f}", os.view(), *value);
+      } else {
+        out = std::format_to(out, "  {} {:>8}", os.view(), "n/a");
+      }
+    }
+  }
+  std::format_to(out, "  (checksum {})\n", checksum);
+}
+}; // namespace
+
+// Usage: erelic-bench [--perf] [--units N]
+//
+// Runs each benchmark for N units of emulated work and prints the wall time per unit. With `--perf`, host hardware
+// counters (cycles, instructions, branch misses, L1D and iTLB misses) are reported per unit as well; BRMS per
+// instruction is the dispatch misprediction rate of the interpreter. The run-ahead benchmarks are also reported as a
+// multiple of a plain frame, with the input changing every frame and held for half a second.
+auto main(int argc, char **argv) -> int {
+  const auto opts = parse(std::span{argv, static_cast<std::size_t>(argc)});
+  if (!opts) {
+    std::cerr << "usage: erelic-bench [--perf] [--units N]\n";
+    return EXIT_FAILURE;
+  }
+
+  auto counters = std::optional<perf_counters>{};
+  if (opts->perf) {
+    counters.emplace();
+    if (!counters->any_available()) {
+      std::cerr << "erelic-bench: no hardware counters available, check perf_event_paranoid\n";
+    }
+  }
+
+  auto times = std::map<std::string_view, std::chrono::nanoseconds>{};
+  for (const auto &bench : make_benchmarks()) {
+    auto checksum = std::uint64_t{0};
+    auto sample = std::optional<perf_sample>{};
+    const auto begin = std::chrono::steady_clock::now();
+    if (counters) {
+      sample = counters->measure([&] { checksum = bench.run(opts->units); });
+    } else {
+      checksum = bench.run(opts->units);
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+    times[bench.name] = elapsed;
+    const auto baseline = times.find(bench.baseline);
+    report(bench, opts->units, elapsed, checksum, sample,
+           baseline == times.end() ? std::nullopt : std::optional{baseline->second});
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,155 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "perf_counters.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace erelic::bench {
+namespace {
+constexpr auto closed = -1;
+
+#if defined(__linux__)
+auto attributes_of(perf_event e) noexcept -> perf_event_attr {
+  constexpr auto cache_read_miss = [](std::uint64_t cache) {
+    return cache | (std::uint64_t{PERF_COUNT_HW_CACHE_OP_READ} << 8U) |
+           (std::uint64_t{PERF_COUNT_HW_CACHE_RESULT_MISS} << 16U);
+  };
+
+  auto attr = perf_event_attr{};
+  attr.size = sizeof(attr);
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  switch (e) {
+    case perf_event::CYCL:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case perf_event::INST:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case perf_event::BRMS:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+    case perf_event::L1DM:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = cache_read_miss(PERF_COUNT_HW_CACHE_L1D);
+      break;
+    case perf_event::ITLB:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = cache_read_miss(PERF_COUNT_HW_CACHE_ITLB);
+      break;
+  }
+  return attr;
+}
+
+auto open_counter(perf_event e) noexcept -> int {
+  auto attr = attributes_of(e);
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+// Counter value extrapolated over the time the event was actually scheduled on the PMU.
+auto read_counter(int fd) noexcept -> std::optional<std::uint64_t> {
+  struct {
+    std::uint64_t value;
+    std::uint64_t enabled;
+    std::uint64_t running;
+  } data{};
+  if (read(fd, &data, sizeof(data)) != sizeof(data) || data.running == 0) {
+    return std::nullopt;
+  }
+  if (data.running == data.enabled) {
+    return data.value;
+  }
+  return static_cast<std::uint64_t>(static_cast<double>(data.value) * static_cast<double>(data.enabled) /
+                                    static_cast<double>(data.running));
+}
+#else
+auto open_counter(perf_event /*unused*/) noexcept -> int { return closed; }
+#endif
+}; // namespace
+
+auto operator<<(std::ostream &os, const perf_event &e) -> std::ostream & {
+  switch (e) {
+    case perf_event::CYCL: os << "CYCL"; break;
+    case perf_event::INST: os << "INST"; break;
+    case perf_event::BRMS: os << "BRMS"; break;
+    case perf_event::L1DM: os << "L1DM"; break;
+    case perf_event::ITLB: os << "ITLB"; break;
+  }
+  return os;
+}
+
+auto perf_sample::per(perf_event e, std::uint64_t units) const noexcept -> std::optional<double> {
+  const auto value = (*this)[e];
+  if (!value || units == 0) {
+    return std::nullopt;
+  }
+  return static_cast<double>(*value) / static_cast<double>(units);
+}
+
+perf_counters::perf_counters() {
+  std::ranges::transform(perf_events, fds.begin(), open_counter);
+}
+
+perf_counters::~perf_counters() {
+#if defined(__linux__)
+  for (const auto fd : fds) {
+    if (fd != closed) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+auto perf_counters::available(perf_event e) const noexcept -> bool {
+  return fds[static_cast<std::size_t>(e)] != closed;
+}
+
+auto perf_counters::any_available() const noexcept -> bool {
+  return std::ranges::any_of(fds, [](int fd) { return fd != closed; });
+}
+
+void perf_counters::start() noexcept {
+#if defined(__linux__)
+  for (const auto fd : fds) {
+    if (fd != closed) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+auto perf_counters::stop() noexcept -> perf_sample {
+  auto sample = perf_sample{};
+#if defined(__linux__)
+  for (const auto fd : fds) {
+    if (fd != closed) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  for (std::size_t i = 0; i < fds.size(); ++i) {
+    if (fds[i] != closed) {
+      sample.values[i] = read_counter(fds[i]);
+    }
+  }
+#endif
+  return sample;
+}
+}; // namespace erelic::bench
@@ -0,0 +1,68 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+
+namespace erelic::bench {
+enum class perf_event {
+  CYCL, // host CPU cycles
+  INST, // host instructions retired
+  BRMS, // branch mispredictions
+  L1DM, // L1 data cache read misses
+  ITLB, // instruction TLB misses
+};
+
+constexpr auto perf_event_count = std::size_t{5};
+constexpr auto perf_events =
+  std::array{perf_event::CYCL, perf_event::INST, perf_event::BRMS, perf_event::L1DM, perf_event::ITLB};
+
+auto operator<<(std::ostream &os, const perf_event &e) -> std::ostream &;
+
+// Counter values of one measured run, scaled for multiplexing. An event is empty if the host does not expose it.
+struct perf_sample {
+  std::array<std::optional<std::uint64_t>, perf_event_count> values{};
+
+  [[nodiscard]] auto operator[](perf_event e) const noexcept -> std::optional<std::uint64_t> {
+    return values[static_cast<std::size_t>(e)];
+  }
+  // Value of `e` per emulated unit of work (instruction, bus access), empty if `e` is unavailable or `units` is zero.
+  [[nodiscard]] auto per(perf_event e, std::uint64_t units) const noexcept -> std::optional<double>;
+};
+
+// Host hardware counters of the calling thread, opened through Linux `perf_event_open` for user space only. Events
+// the kernel refuses (no PMU in a VM, `perf_event_paranoid`, other platforms) are skipped, so a harness can always
+// construct this and report what it gets.
+class perf_counters {
+public:
+  perf_counters();
+  perf_counters(const perf_counters &) = delete;
+  perf_counters(perf_counters &&) = delete;
+  auto operator=(const perf_counters &) -> perf_counters & = delete;
+  auto operator=(perf_counters &&) -> perf_counters & = delete;
+  ~perf_counters();
+
+  [[nodiscard]] auto available(perf_event e) const noexcept -> bool;
+  [[nodiscard]] auto any_available() const noexcept -> bool;
+
+  // Resets and enables all available counters; `stop` disables them and returns their values.
+  void start() noexcept;
+  [[nodiscard]] auto stop() noexcept -> perf_sample;
+
+  template <typename F>
+  [[nodiscard]] auto measure(F &&run) -> perf_sample {
+    start();
+    run();
+    return stop();
+  }
+
+private:
+  std::array<int, perf_event_count> fds{};
+};
+}; // namespace erelic::bench
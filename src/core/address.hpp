@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <array>
 #include <bit>
+#include <compare>
 #include <cstddef>
 #include <cstdint>
 #include <ostream>
@@ -17,6 +18,8 @@ namespace erelic {
 using address_raw = std::uint16_t;
 using address_bytes = std::array<std::byte, sizeof(address_raw)>;
 
+constexpr auto address_space_size = std::size_t{0x10000};
+
 constexpr auto to_address_bytes(address_raw value) noexcept -> address_bytes {
   if constexpr (std::endian::native == std::endian::little) {
     return std::bit_cast<address_bytes>(std::byteswap(value));
@@ -47,7 +50,9 @@ struct address {
   explicit constexpr address(std::span<const std::byte, sizeof(address_raw)> bytes)
       : bytes{to_address_bytes(bytes)}, raw{to_address_raw(to_address_bytes(bytes))} {}
 
-  [[nodiscard]] auto operator<=>(const address &addr) const noexcept -> std::strong_ordering;
+  [[nodiscard]] constexpr auto operator<=>(const address &addr) const noexcept -> std::strong_ordering {
+    return raw <=> addr.raw;
+  }
   [[nodiscard]] auto operator==(const address &addr) const noexcept -> bool = default;
 };
 
@@ -59,9 +64,11 @@ struct address_range {
 
   constexpr address_range(address from, address till) : from{std::min(from, till)}, till{std::max(from, till)} {}
 
-  [[nodiscard]] auto contains(address addr) const noexcept -> bool;
-  [[nodiscard]] auto overlaps(address_range other) const noexcept -> bool;
-  [[nodiscard]] auto size() const noexcept -> size_t;
+  [[nodiscard]] constexpr auto contains(address addr) const noexcept -> bool { return from <= addr && addr <= till; }
+  [[nodiscard]] constexpr auto overlaps(address_range other) const noexcept -> bool {
+    return from <= other.till && other.from <= till;
+  }
+  [[nodiscard]] constexpr auto size() const noexcept -> size_t { return till.raw - from.raw + 1; }
 };
 
 auto operator<<(std::ostream &os, const address_range &r) -> std::ostream &;
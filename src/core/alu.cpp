@@ -0,0 +1,155 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "alu.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace erelic {
+namespace {
+consteval auto nz(unsigned value) -> std::uint8_t {
+  const auto v = value & 0xFFU;
+  return static_cast<std::uint8_t>((v == 0 ? flag_z : 0U) | (v & flag_n));
+}
+
+consteval auto make_result(unsigned value, unsigned flags) -> alu_result {
+  return {.value = static_cast<std::byte>(value & 0xFFU), .flags = static_cast<std::uint8_t>(flags)};
+}
+
+consteval auto binary_adc(unsigned a, unsigned b, unsigned c) -> alu_result {
+  const auto sum = a + b + c;
+  const auto overflow = (~(a ^ b) & (a ^ sum) & 0x80U) != 0 ? flag_v : 0U;
+  return make_result(sum, nz(sum) | overflow | (sum > 0xFFU ? flag_c : 0U));
+}
+
+consteval auto binary_sbc(unsigned a, unsigned b, unsigned c) -> alu_result { return binary_adc(a, ~b & 0xFFU, c); }
+
+// NMOS: N and V are taken from the sum after the low nibble is corrected and before the high one is, Z from the
+// binary sum.
+consteval auto decimal_adc(unsigned a, unsigned b, unsigned c) -> alu_result {
+  auto low = static_cast<int>((a & 0x0FU) + (b & 0x0FU) + c);
+  if (low >= 0x0A) {
+    low = ((low + 0x06) & 0x0F) + 0x10;
+  }
+  const auto signed_high = [](unsigned v) { return static_cast<int>(v & 0xF0U) - ((v & 0x80U) != 0 ? 0x100 : 0); };
+  const auto intermediate = signed_high(a) + signed_high(b) + low;
+  const auto overflow = intermediate < -128 || intermediate > 127 ? flag_v : 0U;
+  auto sum = static_cast<int>((a & 0xF0U) + (b & 0xF0U)) + low;
+  if (sum >= 0xA0) {
+    sum += 0x60;
+  }
+  const auto zero = binary_adc(a, b, c).flags & flag_z;
+  const auto carry = sum >= 0x100 ? flag_c : 0U;
+  const auto negative = static_cast<unsigned>(intermediate) & flag_n;
+  return make_result(static_cast<unsigned>(sum), negative | overflow | zero | carry);
+}
+
+// NMOS: all flags are taken from the binary difference.
+consteval auto decimal_sbc(unsigned a, unsigned b, unsigned c) -> alu_result {
+  auto low = static_cast<int>(a & 0x0FU) - static_cast<int>(b & 0x0FU) + static_cast<int>(c) - 1;
+  if (low < 0) {
+    low = ((low - 0x06) & 0x0F) - 0x10;
+  }
+  auto difference = static_cast<int>(a & 0xF0U) - static_cast<int>(b & 0xF0U) + low;
+  if (difference < 0) {
+    difference -= 0x60;
+  }
+  return make_result(static_cast<unsigned>(difference), binary_sbc(a, b, c).flags);
+}
+
+consteval auto compare_entry(unsigned r, unsigned m) -> alu_result {
+  const auto difference = r - m;
+  return make_result(difference, nz(difference) | (r >= m ? flag_c : 0U));
+}
+
+// `t` is `A & imm`. In binary mode C is bit 6 of the result and V is bit 6 xor bit 5; in decimal mode N, V and Z come
+// from the rotated value and each nibble is then corrected on its own.
+consteval auto arr_entry(unsigned t, unsigned c, bool decimal) -> alu_result {
+  auto result = (t >> 1U) | (c << 7U);
+  if (!decimal) {
+    const auto overflow = (((result >> 6U) ^ (result >> 5U)) & 1U) != 0 ? flag_v : 0U;
+    return make_result(result, nz(result) | overflow | ((result & 0x40U) != 0 ? flag_c : 0U));
+  }
+  const auto flags = nz(result) | (((t ^ result) & 0x40U) != 0 ? flag_v : 0U);
+  if ((t & 0x0FU) + (t & 0x01U) > 0x05U) {
+    result = (result & 0xF0U) | ((result + 0x06U) & 0x0FU);
+  }
+  const auto carry = (t & 0xF0U) + (t & 0x10U) > 0x50U;
+  if (carry) {
+    result += 0x60U;
+  }
+  return make_result(result, flags | (carry ? flag_c : 0U));
+}
+
+consteval auto shift_result(unsigned result, bool carry) -> alu_result {
+  return make_result(result, nz(result) | (carry ? flag_c : 0U));
+}
+
+template <auto Op>
+consteval auto make_alu_table() {
+  auto table = alu_table{};
+  for (auto c = 0U; c < 2; ++c) {
+    for (auto a = 0U; a < 0x100; ++a) {
+      for (auto b = 0U; b < 0x100; ++b) {
+        table[(c << 16U) | (a << 8U) | b] = Op(a, b, c);
+      }
+    }
+  }
+  return table;
+}
+
+consteval auto make_compare_table() {
+  auto table = std::array<alu_result, 0x10000>{};
+  for (auto r = 0U; r < 0x100; ++r) {
+    for (auto m = 0U; m < 0x100; ++m) {
+      table[(r << 8U) | m] = compare_entry(r, m);
+    }
+  }
+  return table;
+}
+
+consteval auto make_arr_table() {
+  auto table = std::array<alu_result, 0x400>{};
+  for (auto i = 0U; i < table.size(); ++i) {
+    table[i] = arr_entry(i & 0xFFU, (i >> 8U) & 1U, (i >> 9U) != 0);
+  }
+  return table;
+}
+
+// Indexed by `(carry << 8) | value`; ASL and LSR ignore the carry half.
+template <auto Op>
+consteval auto make_shift_table() {
+  auto table = std::array<alu_result, 0x200>{};
+  for (auto i = 0U; i < table.size(); ++i) {
+    table[i] = Op(i & 0xFFU, i >> 8U);
+  }
+  return table;
+}
+
+consteval auto asl_entry(unsigned v, unsigned /*unused*/) -> alu_result {
+  return shift_result(v << 1U, (v & 0x80U) != 0);
+}
+consteval auto lsr_entry(unsigned v, unsigned /*unused*/) -> alu_result {
+  return shift_result(v >> 1U, (v & 0x01U) != 0);
+}
+consteval auto rol_entry(unsigned v, unsigned c) -> alu_result {
+  return shift_result((v << 1U) | c, (v & 0x80U) != 0);
+}
+consteval auto ror_entry(unsigned v, unsigned c) -> alu_result {
+  return shift_result((v >> 1U) | (c << 7U), (v & 0x01U) != 0);
+}
+}; // namespace
+
+constexpr alu_table binary_adc_table = make_alu_table<binary_adc>();
+constexpr alu_table decimal_adc_table = make_alu_table<decimal_adc>();
+constexpr alu_table decimal_sbc_table = make_alu_table<decimal_sbc>();
+constexpr std::array<alu_result, 0x10000> compare_table = make_compare_table();
+constexpr std::array<alu_result, 0x400> arr_table = make_arr_table();
+constexpr std::array<alu_result, 0x200> asl_table = make_shift_table<asl_entry>();
+constexpr std::array<alu_result, 0x200> lsr_table = make_shift_table<lsr_entry>();
+constexpr std::array<alu_result, 0x200> rol_table = make_shift_table<rol_entry>();
+constexpr std::array<alu_result, 0x200> ror_table = make_shift_table<ror_entry>();
+}; // namespace erelic
@@ -0,0 +1,82 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace erelic {
+// Status register bits.
+constexpr auto flag_c = std::uint8_t{0x01};
+constexpr auto flag_z = std::uint8_t{0x02};
+constexpr auto flag_i = std::uint8_t{0x04};
+constexpr auto flag_d = std::uint8_t{0x08};
+constexpr auto flag_b = std::uint8_t{0x10};
+constexpr auto flag_v = std::uint8_t{0x40};
+constexpr auto flag_n = std::uint8_t{0x80};
+
+// Result of an ALU operation. `flags` holds the operation's outputs among N, V, Z and C; the status register keeps its
+// other bits: `p = (p & ~affected) | flags`, with `affected` the mask documented per operation.
+struct alu_result {
+  std::byte value{0x00};
+  std::uint8_t flags = 0;
+
+  auto operator==(const alu_result &o) const noexcept -> bool = default;
+};
+
+// Indexed by `alu_index(a, b, carry)`.
+using alu_table = std::array<alu_result, 0x20000>;
+
+// Tables generated at compile time, one indexed load per operation. Decimal mode follows the NMOS 6502: the result is
+// BCD corrected, N and V come from the intermediate sum after the low nibble correction and Z from the binary sum;
+// decimal SBC takes all flags from the binary difference. Undocumented combos compose them: RRA is `ror` then `adc`,
+// ISC is an increment then `sbc`, SBX and DCP set flags like `compare`.
+extern const alu_table binary_adc_table;
+extern const alu_table decimal_adc_table;
+extern const alu_table decimal_sbc_table;
+extern const std::array<alu_result, 0x10000> compare_table;
+extern const std::array<alu_result, 0x400> arr_table;
+extern const std::array<alu_result, 0x200> asl_table;
+extern const std::array<alu_result, 0x200> lsr_table;
+extern const std::array<alu_result, 0x200> rol_table;
+extern const std::array<alu_result, 0x200> ror_table;
+
+constexpr auto alu_index(std::byte a, std::byte b, bool carry) noexcept -> std::size_t {
+  return (static_cast<std::size_t>(carry) << 16U) | (std::to_integer<std::size_t>(a) << 8U) |
+         std::to_integer<std::size_t>(b);
+}
+
+// Affects N, V, Z and C.
+[[nodiscard]] inline auto adc(std::byte a, std::byte b, bool carry, bool decimal) noexcept -> alu_result {
+  return (decimal ? decimal_adc_table : binary_adc_table)[alu_index(a, b, carry)];
+}
+
+// Affects N, V, Z and C. Binary SBC is ADC of the complement.
+[[nodiscard]] inline auto sbc(std::byte a, std::byte b, bool carry, bool decimal) noexcept -> alu_result {
+  return decimal ? decimal_sbc_table[alu_index(a, b, carry)] : binary_adc_table[alu_index(a, ~b, carry)];
+}
+
+// `r - m` for CMP, CPX, CPY, DCP and SBX. Affects N, Z and C.
+[[nodiscard]] inline auto compare(std::byte r, std::byte m) noexcept -> alu_result {
+  return compare_table[alu_index(r, m, false)];
+}
+
+// ARR of `a & imm`. Affects N, V, Z and C.
+[[nodiscard]] inline auto arr(std::byte a, std::byte imm, bool carry, bool decimal) noexcept -> alu_result {
+  return arr_table[(static_cast<std::size_t>(decimal) << 9U) | (static_cast<std::size_t>(carry) << 8U) |
+                   std::to_integer<std::size_t>(a & imm)];
+}
+
+// Shifts and rotates affect N, Z and C.
+[[nodiscard]] inline auto asl(std::byte v) noexcept -> alu_result { return asl_table[std::to_integer<std::size_t>(v)]; }
+[[nodiscard]] inline auto lsr(std::byte v) noexcept -> alu_result { return lsr_table[std::to_integer<std::size_t>(v)]; }
+[[nodiscard]] inline auto rol(std::byte v, bool carry) noexcept -> alu_result {
+  return rol_table[(static_cast<std::size_t>(carry) << 8U) | std::to_integer<std::size_t>(v)];
+}
+[[nodiscard]] inline auto ror(std::byte v, bool carry) noexcept -> alu_result {
+  return ror_table[(static_cast<std::size_t>(carry) << 8U) | std::to_integer<std::size_t>(v)];
+}
+}; // namespace erelic
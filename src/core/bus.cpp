@@ -0,0 +1,175 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "bus.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace erelic {
+namespace {
+auto relative_to(address_range range, address absolute) noexcept -> address {
+  return address{static_cast<address_raw>(absolute.raw - range.from.raw)};
+}
+}; // namespace
+
+bus::bus(std::pmr::memory_resource *resource) : mappings{resource}, counts(1, resource) {}
+
+void bus::map(address_range range, device dev) {
+  if (std::ranges::any_of(mappings, [&](const mapping &m) { return m.range.overlaps(range); })) {
+    throw std::invalid_argument("bus: address range overlaps an already mapped device");
+  }
+  mappings.push_back({range, std::move(dev)});
+  counts.insert(std::prev(counts.end()), device_counts{});
+}
+
+auto bus::find(address absolute) const noexcept -> std::size_t {
+  const auto it = std::ranges::find_if(mappings, [&](const mapping &m) { return m.range.contains(absolute); });
+  return static_cast<std::size_t>(std::distance(mappings.begin(), it));
+}
+
+auto bus::read(address absolute) const noexcept -> std::byte {
+  const auto index = find(absolute);
+  if (counting) {
+    ++counts[index].reads;
+  }
+  if (index == mappings.size()) {
+    return unmapped_read;
+  }
+  const auto &m = mappings[index];
+  return m.dev.read(absolute, relative_to(m.range, absolute));
+}
+
+auto bus::write(address absolute, std::byte value) noexcept -> write_status {
+  const auto index = find(absolute);
+  if (index == mappings.size()) {
+    if (counting) {
+      counts[index].count(write_status::FAILED);
+    }
+    return write_status::FAILED;
+  }
+  auto &m = mappings[index];
+  const auto status = m.dev.write(absolute, relative_to(m.range, absolute), value);
+  if (status == write_status::WRITTEN) {
+    ++versions[page_of(absolute)];
+    if (tracker != nullptr) {
+      tracker->write(absolute, value);
+    }
+  }
+  if (counting) {
+    counts[index].count(status);
+  }
+  return status;
+}
+
+auto bus::stable_until(address absolute, std::uint64_t now) const noexcept -> std::uint64_t {
+  const auto index = find(absolute);
+  if (index == mappings.size()) {
+    return std::numeric_limits<std::uint64_t>::max();
+  }
+  const auto &m = mappings[index];
+  return m.dev.stable_until(relative_to(m.range, absolute), now);
+}
+
+auto bus::backing(std::size_t page) noexcept -> std::span<std::byte> {
+  const auto first = address{static_cast<address_raw>(page * page_size)};
+  const auto last = address{static_cast<address_raw>(first.raw + page_size - 1)};
+  const auto index = find(first);
+  if (index == mappings.size() || !mappings[index].range.contains(last)) {
+    return {};
+  }
+  auto &m = mappings[index];
+  const auto memory = m.dev.memory();
+  const auto offset = relative_to(m.range, first).raw;
+  if (memory.size() < offset + page_size) {
+    return {};
+  }
+  return memory.subspan(offset, page_size);
+}
+
+auto bus::bind_page(std::size_t page) noexcept -> std::span<std::byte> {
+  if (tracker != nullptr) {
+    return {};
+  }
+  const auto memory = backing(page);
+  if (!memory.empty()) {
+    bound.set(page);
+  }
+  return memory;
+}
+
+auto bus::page_memory(std::size_t page) noexcept -> std::span<const std::byte> { return backing(page); }
+
+auto bus::load_page(std::size_t page, std::span<const std::byte, page_size> bytes) noexcept -> bool {
+  const auto memory = backing(page);
+  if (memory.empty()) {
+    return false;
+  }
+  if (tracker != nullptr) {
+    for (auto i = std::size_t{0}; i < page_size; ++i) {
+      tracker->write(address{static_cast<address_raw>(page * page_size + i)}, bytes[i]);
+    }
+  }
+  std::ranges::copy(bytes, memory.begin());
+  ++versions[page];
+  return true;
+}
+
+auto bus::dirty_pages() const noexcept -> const page_mask & {
+  dirty = bound;
+  for (auto page = std::size_t{0}; page < page_count; ++page) {
+    if (versions[page] != cleared[page]) {
+      dirty.set(page);
+    }
+  }
+  return dirty;
+}
+
+void bus::clear_dirty_pages() noexcept { cleared = versions; }
+
+auto bus::page_versions() const noexcept -> std::span<const std::uint64_t, page_count> { return versions; }
+
+auto bus::bound_pages() const noexcept -> const page_mask & { return bound; }
+
+void bus::save_device_state(std::ostream &os) const {
+  for (const auto &m : mappings) {
+    m.dev.save_state(os);
+  }
+}
+
+void bus::load_device_state(std::istream &is) {
+  for (auto &m : mappings) {
+    m.dev.load_state(is);
+  }
+}
+
+void bus::save_device_state(std::size_t index, std::ostream &os) const { mappings[index].dev.save_state(os); }
+
+void bus::load_device_state(std::size_t index, std::istream &is) { mappings[index].dev.load_state(is); }
+
+auto bus::device_count() const noexcept -> std::size_t { return mappings.size(); }
+
+void bus::count_accesses(bool enabled) noexcept { counting = enabled; }
+
+auto bus::access_counts() const noexcept -> std::span<const device_counts> { return counts; }
+
+void bus::reset_access_counts() noexcept { std::ranges::fill(counts, device_counts{}); }
+
+auto bus::track_state(state_hash *hash) noexcept -> bool {
+  if (hash != nullptr && bound.any()) {
+    return false;
+  }
+  tracker = hash;
+  return true;
+}
+}; // namespace erelic
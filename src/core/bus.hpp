@@ -0,0 +1,119 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory_resource>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "address.hpp"
+#include "device.hpp"
+#include "state_hash.hpp"
+#include "statistics.hpp"
+
+namespace erelic {
+// Value returned for reads from an address no device is mapped to.
+constexpr auto unmapped_read = std::byte{0x00};
+
+// Interface the CPU core talks to; satisfied by both the runtime `bus` and the compile-time `static_bus`.
+template <typename T>
+concept io_bus = requires(const T bus, address a) {
+  { bus.read(a) } noexcept -> std::same_as<std::byte>;
+} && requires(T bus, address a, std::byte v) {
+  { bus.write(a, v) } noexcept -> std::same_as<write_status>;
+};
+
+constexpr auto page_size = std::size_t{0x100};
+constexpr auto page_count = std::size_t{0x100};
+
+constexpr auto page_of(address absolute) noexcept -> std::size_t { return absolute.raw / page_size; }
+
+using page_mask = std::bitset<page_count>;
+
+class bus {
+public:
+  bus() = default;
+  // Mapping table and access counts are allocated from `resource`, which must outlive the bus.
+  explicit bus(std::pmr::memory_resource *resource);
+
+  // Throws `std::invalid_argument` if `range` overlaps an already mapped range.
+  void map(address_range range, device dev);
+
+  [[nodiscard]] auto read(address absolute) const noexcept -> std::byte;
+  [[nodiscard]] auto write(address absolute, std::byte value) noexcept -> write_status;
+
+  // See `pollable_device`. Unmapped addresses are stable forever.
+  [[nodiscard]] auto stable_until(address absolute, std::uint64_t now) const noexcept -> std::uint64_t;
+
+  // The `page_size` bytes of `page` if they all belong to one `memory_device`, empty otherwise. Accesses through the
+  // span bypass dirty tracking, access counting and state tracking, so a bound page is reported dirty from then on,
+  // and no page is bound while a `state_hash` is attached. The span stays valid until the next `map`.
+  [[nodiscard]] auto bind_page(std::size_t page) noexcept -> std::span<std::byte>;
+
+  // Read-only view of the `page_size` bytes of `page` if they all belong to one `memory_device`, empty otherwise.
+  // Unlike `bind_page` this leaves the page unbound.
+  [[nodiscard]] auto page_memory(std::size_t page) noexcept -> std::span<const std::byte>;
+  // Copies `bytes` into the memory backing `page` without going through device writes, marking the page dirty and
+  // feeding the state tracker. Returns false, copying nothing, if `page_memory(page)` is empty.
+  auto load_page(std::size_t page, std::span<const std::byte, page_size> bytes) noexcept -> bool;
+
+  // Pages that received a `write_status::WRITTEN` write since the last `clear_dirty_pages`, plus all bound pages.
+  [[nodiscard]] auto dirty_pages() const noexcept -> const page_mask &;
+  void clear_dirty_pages() noexcept;
+
+  // Number of `write_status::WRITTEN` writes and `load_page` calls per page, for consumers that track changes on
+  // their own schedule instead of through `clear_dirty_pages`. Accesses through bound pages are not counted; treat
+  // `bound_pages` as always changed.
+  [[nodiscard]] auto page_versions() const noexcept -> std::span<const std::uint64_t, page_count>;
+  [[nodiscard]] auto bound_pages() const noexcept -> const page_mask &;
+
+  // State of every mapped device, in mapping order.
+  void save_device_state(std::ostream &os) const;
+  void load_device_state(std::istream &is);
+  // State of the device mapped `index`-th.
+  void save_device_state(std::size_t index, std::ostream &os) const;
+  void load_device_state(std::size_t index, std::istream &is);
+  [[nodiscard]] auto device_count() const noexcept -> std::size_t;
+
+  // Per-device access counting, off by default. Counts are in mapping order followed by one entry for unmapped
+  // addresses, ready to be handed to `statistics::publish`.
+  void count_accesses(bool enabled) noexcept;
+  [[nodiscard]] auto access_counts() const noexcept -> std::span<const device_counts>;
+  void reset_access_counts() noexcept;
+
+  // Feeds every `write_status::WRITTEN` write to `hash`, which must outlive the bus or be detached with `nullptr`.
+  // Writes through bound pages would bypass it, so attaching fails and returns false once a page is bound.
+  [[nodiscard]] auto track_state(state_hash *hash) noexcept -> bool;
+
+private:
+  struct mapping {
+    address_range range;
+    device dev;
+  };
+
+  // Index of the mapping containing `absolute`, or `mappings.size()` if none.
+  [[nodiscard]] auto find(address absolute) const noexcept -> std::size_t;
+  // Memory backing the whole of `page`, or empty.
+  [[nodiscard]] auto backing(std::size_t page) noexcept -> std::span<std::byte>;
+
+private:
+  std::pmr::vector<mapping> mappings;
+  std::array<std::uint64_t, page_count> versions{};
+  std::array<std::uint64_t, page_count> cleared{};
+  // Derived from the above by `dirty_pages`.
+  mutable page_mask dirty;
+  page_mask bound;
+  bool counting = false;
+  state_hash *tracker = nullptr;
+  mutable std::pmr::vector<device_counts> counts = std::pmr::vector<device_counts>(1);
+};
+}; // namespace erelic
@@ -0,0 +1,41 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "address.hpp"
+#include "device.hpp"
+
+namespace erelic {
+// ROM whose image is a `constexpr` array, typically one generated by the `embed_rom` CMake function. The image is a
+// template argument, so the device is empty, `read` is a constant expression and, mapped into a `static_bus`, fetches
+// from constant addresses fold to the byte itself. Images smaller than the mapped range are mirrored.
+template <const auto &Image>
+  requires std::same_as<std::remove_cvref_t<decltype(Image)>, std::array<std::byte, Image.size()>>
+class constexpr_rom_device {
+public:
+  static constexpr auto size = Image.size();
+  static_assert(size != 0, "constexpr_rom_device: empty image");
+
+  [[nodiscard]] static constexpr auto read(address /*unused*/, address relative) noexcept -> std::byte {
+    return Image[relative.raw % size];
+  }
+  [[nodiscard]] static constexpr auto write(address /*unused*/, address /*unused*/, std::byte /*unused*/) noexcept
+    -> write_status {
+    return write_status::IGNORED;
+  }
+  // Contents never change, so polling loops over the ROM can be fast-forwarded.
+  [[nodiscard]] static constexpr auto stable_until(address /*unused*/, std::uint64_t /*unused*/) noexcept
+    -> std::uint64_t {
+    return std::numeric_limits<std::uint64_t>::max();
+  }
+};
+}; // namespace erelic
@@ -0,0 +1,107 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "address.hpp"
+#include "instruction.hpp"
+#include "registers.hpp"
+#include "statistics.hpp"
+
+namespace erelic {
+// Instrumentation policy of the execution core, chosen at compile time so an uninstrumented build pays nothing.
+// `on_fetch` sees every opcode fetch, `on_read` and `on_write` every bus access including the fetch and dummy cycles,
+// `on_interrupt` the vector of every interrupt taken and `on_retire` every completed instruction with the address it
+// started at and the registers after it.
+template <typename T>
+concept core_hooks = requires(T hooks, address a, std::byte value, const instruction &info, const registers &regs) {
+  { hooks.on_fetch(a, value) } noexcept;
+  { hooks.on_read(a, value) } noexcept;
+  { hooks.on_write(a, value) } noexcept;
+  { hooks.on_interrupt(a) } noexcept;
+  { hooks.on_retire(a, info, regs) } noexcept;
+};
+
+// Default policy; empty and inlined away.
+struct no_hooks {
+  void on_fetch(address /*unused*/, std::byte /*unused*/) noexcept {}
+  void on_read(address /*unused*/, std::byte /*unused*/) noexcept {}
+  void on_write(address /*unused*/, std::byte /*unused*/) noexcept {}
+  void on_interrupt(address /*unused*/) noexcept {}
+  void on_retire(address /*unused*/, const instruction & /*unused*/, const registers & /*unused*/) noexcept {}
+};
+
+static_assert(core_hooks<no_hooks>);
+static_assert(std::is_empty_v<no_hooks>);
+
+// Map fed with the address of every fetched opcode, e.g. `pc_coverage` or `edge_coverage`.
+template <typename T>
+concept fetch_map = requires(T map, address pc) {
+  { map.mark(pc) } noexcept;
+};
+
+template <fetch_map Map>
+struct coverage_hooks : no_hooks {
+  Map *map;
+
+  explicit coverage_hooks(Map &map) noexcept : map{&map} {}
+
+  void on_fetch(address pc, std::byte /*unused*/) noexcept { map->mark(pc); }
+};
+
+// Profiling counters; every bus access is one cycle.
+struct counting_hooks : no_hooks {
+  core_counts *counts;
+
+  explicit counting_hooks(core_counts &counts) noexcept : counts{&counts} {}
+
+  void on_read(address /*unused*/, std::byte /*unused*/) noexcept { ++counts->cycles; }
+  void on_write(address /*unused*/, std::byte /*unused*/) noexcept { ++counts->cycles; }
+  void on_interrupt(address /*unused*/) noexcept { ++counts->interrupts; }
+  void on_retire(address /*unused*/, const instruction & /*unused*/, const registers & /*unused*/) noexcept {
+    ++counts->instructions;
+  }
+};
+
+// Hands every retired instruction to `sink`.
+template <typename Sink>
+  requires std::is_nothrow_invocable_v<Sink &, address, const instruction &, const registers &>
+struct trace_hooks : no_hooks {
+  Sink sink;
+
+  explicit trace_hooks(Sink sink) noexcept(std::is_nothrow_move_constructible_v<Sink>) : sink{std::move(sink)} {}
+
+  void on_retire(address pc, const instruction &info, const registers &regs) noexcept { sink(pc, info, regs); }
+};
+
+// Runs several policies in order.
+template <core_hooks... Hooks>
+struct hooks_chain {
+  std::tuple<Hooks...> hooks;
+
+  explicit hooks_chain(Hooks... hooks) noexcept((std::is_nothrow_move_constructible_v<Hooks> && ...))
+      : hooks{std::move(hooks)...} {}
+
+  void on_fetch(address pc, std::byte opcode) noexcept {
+    std::apply([&](auto &...h) { (h.on_fetch(pc, opcode), ...); }, hooks);
+  }
+  void on_read(address a, std::byte value) noexcept {
+    std::apply([&](auto &...h) { (h.on_read(a, value), ...); }, hooks);
+  }
+  void on_write(address a, std::byte value) noexcept {
+    std::apply([&](auto &...h) { (h.on_write(a, value), ...); }, hooks);
+  }
+  void on_interrupt(address vector) noexcept {
+    std::apply([&](auto &...h) { (h.on_interrupt(vector), ...); }, hooks);
+  }
+  void on_retire(address pc, const instruction &info, const registers &regs) noexcept {
+    std::apply([&](auto &...h) { (h.on_retire(pc, info, regs), ...); }, hooks);
+  }
+};
+}; // namespace erelic
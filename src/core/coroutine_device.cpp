@@ -0,0 +1,111 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "coroutine_device.hpp"
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <utility>
+
+namespace {
+// Each frame is preceded by its owning pool so that `operator delete` can find it.
+constexpr auto frame_header = alignof(std::max_align_t);
+
+constexpr auto later = [](const auto &lhs, const auto &rhs) noexcept {
+  return lhs.cycle != rhs.cycle ? lhs.cycle > rhs.cycle : lhs.order > rhs.order;
+};
+}; // namespace
+
+namespace erelic {
+frame_pool::frame_pool(std::size_t block_size, std::size_t block_count)
+    : block_size{(block_size + frame_header + frame_header - 1) / frame_header * frame_header},
+      storage(this->block_size * block_count) {
+  free_blocks.reserve(block_count);
+  for (auto i = block_count; i > 0; --i) {
+    free_blocks.push_back(storage.data() + (i - 1) * this->block_size);
+  }
+}
+
+auto frame_pool::allocate(std::size_t size) -> void * {
+  if (size > block_size || free_blocks.empty()) {
+    throw std::bad_alloc();
+  }
+  auto *block = free_blocks.back();
+  free_blocks.pop_back();
+  return block;
+}
+
+void frame_pool::deallocate(void *block) noexcept { free_blocks.push_back(block); }
+
+auto frame_pool::used() const noexcept -> std::size_t { return storage.size() / block_size - free_blocks.size(); }
+
+auto device_task::allocate(std::size_t size, frame_pool &pool) -> void * {
+  auto *block = static_cast<std::byte *>(pool.allocate(size + frame_header));
+  ::new (block) frame_pool *(&pool);
+  return block + frame_header;
+}
+
+void device_task::deallocate(void *frame) noexcept {
+  auto *block = static_cast<std::byte *>(frame) - frame_header;
+  (*std::launder(reinterpret_cast<frame_pool **>(block)))->deallocate(block);
+}
+
+device_task::device_task(std::coroutine_handle<> handle) noexcept : handle{handle} {}
+
+device_task::device_task(device_task &&other) noexcept : handle{std::exchange(other.handle, nullptr)} {}
+
+auto device_task::operator=(device_task &&other) noexcept -> device_task & {
+  if (this != &other) {
+    if (handle) {
+      handle.destroy();
+    }
+    handle = std::exchange(other.handle, nullptr);
+  }
+  return *this;
+}
+
+device_task::~device_task() {
+  if (handle) {
+    handle.destroy();
+  }
+}
+
+auto device_task::done() const noexcept -> bool { return !handle || handle.done(); }
+
+cycle_scheduler::cycle_scheduler(std::size_t capacity) { waiters.reserve(capacity); }
+
+auto cycle_scheduler::until(std::uint64_t cycle) noexcept -> deadline { return deadline{*this, cycle}; }
+
+auto cycle_scheduler::after(std::uint64_t cycles) noexcept -> deadline { return deadline{*this, current + cycles}; }
+
+auto cycle_scheduler::enqueue(std::uint64_t cycle, std::coroutine_handle<> handle) noexcept -> bool {
+  if (waiters.size() == waiters.capacity()) {
+    return false;
+  }
+  waiters.push_back({cycle, enqueued++, handle});
+  std::ranges::push_heap(waiters, later);
+  return true;
+}
+
+void cycle_scheduler::advance_to(std::uint64_t cycle) {
+  while (!waiters.empty() && waiters.front().cycle <= cycle) {
+    std::ranges::pop_heap(waiters, later);
+    const auto next = waiters.back();
+    waiters.pop_back();
+    current = std::max(current, next.cycle);
+    next.handle.resume();
+  }
+  current = std::max(current, cycle);
+}
+
+auto cycle_scheduler::now() const noexcept -> std::uint64_t { return current; }
+
+auto cycle_scheduler::next_deadline() const noexcept -> std::optional<std::uint64_t> {
+  return waiters.empty() ? std::nullopt : std::optional{waiters.front().cycle};
+}
+}; // namespace erelic
@@ -0,0 +1,203 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "address.hpp"
+#include "device.hpp"
+
+namespace erelic {
+// Fixed pool of equally sized blocks for coroutine frames; both operations are O(1) and never touch the heap after
+// construction. Not thread-safe: frames are created and destroyed on the emulation thread.
+class frame_pool {
+public:
+  // Blocks hold frames of up to `block_size` bytes.
+  frame_pool(std::size_t block_size, std::size_t block_count);
+
+  // Throws `std::bad_alloc` if the request does not fit a block or the pool is exhausted.
+  [[nodiscard]] auto allocate(std::size_t size) -> void *;
+  void deallocate(void *block) noexcept;
+
+  [[nodiscard]] auto used() const noexcept -> std::size_t;
+
+private:
+  std::size_t block_size;
+  std::vector<std::byte> storage;
+  std::vector<void *> free_blocks;
+};
+
+// Coroutine type of a device body. The body must take a `frame_pool &` parameter; its frame is carved from the first
+// such pool. The body starts running when called.
+class device_task {
+public:
+  // Promise of a body with parameters `Args`, the object first for member coroutines. The allocation functions are
+  // plain members of it rather than member templates, so every frame allocation has a matching deallocation.
+  template <typename... Args>
+  struct promise {
+    static auto operator new(std::size_t size, Args &...args) -> void * { return allocate(size, pool_of(args...)); }
+    static void operator delete(void *frame) noexcept { deallocate(frame); }
+
+    auto get_return_object() noexcept -> device_task {
+      return device_task{std::coroutine_handle<promise>::from_promise(*this)};
+    }
+    static auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+    static auto final_suspend() noexcept -> std::suspend_always { return {}; }
+    static void return_void() noexcept {}
+    static void unhandled_exception() noexcept { std::terminate(); }
+  };
+
+  device_task(const device_task &) = delete;
+  device_task(device_task &&other) noexcept;
+  auto operator=(const device_task &) -> device_task & = delete;
+  auto operator=(device_task &&other) noexcept -> device_task &;
+  // A task must not be destroyed while it is still suspended on a scheduler or device that will resume it.
+  ~device_task();
+
+  [[nodiscard]] auto done() const noexcept -> bool;
+
+private:
+  explicit device_task(std::coroutine_handle<> handle) noexcept;
+
+  template <typename First, typename... Rest>
+  static auto pool_of(First &first, Rest &...rest) noexcept -> frame_pool & {
+    if constexpr (std::is_same_v<std::remove_cvref_t<First>, frame_pool>) {
+      return first;
+    } else {
+      static_assert(sizeof...(Rest) > 0, "device_task: the body takes no frame_pool");
+      return pool_of(rest...);
+    }
+  }
+
+  static auto allocate(std::size_t size, frame_pool &pool) -> void *;
+  static void deallocate(void *frame) noexcept;
+
+private:
+  std::coroutine_handle<> handle;
+};
+}; // namespace erelic
+
+template <typename... Args>
+struct std::coroutine_traits<erelic::device_task, Args...> {
+  using promise_type = erelic::device_task::promise<Args...>;
+};
+
+namespace erelic {
+// Emulated time source resuming device bodies at their cycle deadlines, earliest first and in suspension order for
+// equal deadlines. Waiters are kept in storage reserved up front for `capacity` simultaneous deadlines.
+class cycle_scheduler {
+public:
+  explicit cycle_scheduler(std::size_t capacity);
+
+  // Evaluates to `false` if the scheduler already holds `capacity` waiters; the body then resumes at once instead of
+  // waiting for the deadline.
+  class deadline {
+  public:
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return cycle <= scheduler->current; }
+    auto await_suspend(std::coroutine_handle<> waiter) noexcept -> bool {
+      scheduled = scheduler->enqueue(cycle, waiter);
+      return scheduled;
+    }
+    auto await_resume() const noexcept -> bool { return scheduled; }
+
+  private:
+    friend class cycle_scheduler;
+    deadline(cycle_scheduler &scheduler, std::uint64_t cycle) noexcept : scheduler{&scheduler}, cycle{cycle} {}
+
+    cycle_scheduler *scheduler;
+    std::uint64_t cycle;
+    bool scheduled = true;
+  };
+
+  [[nodiscard]] auto until(std::uint64_t cycle) noexcept -> deadline;
+  [[nodiscard]] auto after(std::uint64_t cycles) noexcept -> deadline;
+
+  // Resumes every body whose deadline is at or before `cycle`; `now()` equals that deadline while it runs.
+  void advance_to(std::uint64_t cycle);
+
+  [[nodiscard]] auto now() const noexcept -> std::uint64_t;
+  [[nodiscard]] auto next_deadline() const noexcept -> std::optional<std::uint64_t>;
+
+private:
+  struct waiter {
+    std::uint64_t cycle;
+    std::uint64_t order;
+    std::coroutine_handle<> handle;
+  };
+
+  // False when `capacity` bodies already wait.
+  [[nodiscard]] auto enqueue(std::uint64_t cycle, std::coroutine_handle<> handle) noexcept -> bool;
+
+private:
+  std::vector<waiter> waiters;
+  std::uint64_t current = 0;
+  std::uint64_t enqueued = 0;
+};
+
+struct bus_write {
+  address relative;
+  std::byte value;
+};
+
+// Bus-facing side of a coroutine device: reads are served from `registers`, which the body maintains, and every write
+// is stored there and resumes a body waiting in `next_write()`. A write arriving while the body waits on something
+// else is kept as pending, and only the latest one is. The body holds a reference to it, so map it through
+// `device{std::make_shared<coroutine_device<N>>()}`.
+template <std::size_t Registers>
+class coroutine_device {
+public:
+  class write_event {
+  public:
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return dev->pending.has_value(); }
+    void await_suspend(std::coroutine_handle<> waiter) noexcept { dev->waiting = waiter; }
+    [[nodiscard]] auto await_resume() noexcept -> bus_write { return *std::exchange(dev->pending, std::nullopt); }
+
+  private:
+    friend class coroutine_device;
+    explicit write_event(coroutine_device &dev) noexcept : dev{&dev} {}
+
+    coroutine_device *dev;
+  };
+
+  coroutine_device() = default;
+  coroutine_device(const coroutine_device &) = delete;
+  coroutine_device(coroutine_device &&) = delete;
+  auto operator=(const coroutine_device &) -> coroutine_device & = delete;
+  auto operator=(coroutine_device &&) -> coroutine_device & = delete;
+  ~coroutine_device() = default;
+
+  [[nodiscard]] auto next_write() noexcept -> write_event { return write_event{*this}; }
+
+  [[nodiscard]] auto read(address /*absolute*/, address relative) const noexcept -> std::byte {
+    return relative.raw < Registers ? registers[relative.raw] : std::byte{0};
+  }
+
+  [[nodiscard]] auto write(address /*absolute*/, address relative, std::byte value) noexcept -> write_status {
+    if (relative.raw >= Registers) {
+      return write_status::FAILED;
+    }
+    registers[relative.raw] = value;
+    pending = bus_write{relative, value};
+    if (waiting) {
+      std::exchange(waiting, nullptr).resume();
+    }
+    return write_status::WRITTEN;
+  }
+
+  std::array<std::byte, Registers> registers{};
+
+private:
+  std::optional<bus_write> pending;
+  std::coroutine_handle<> waiting;
+};
+}; // namespace erelic
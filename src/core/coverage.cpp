@@ -0,0 +1,50 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "coverage.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <stdexcept>
+
+namespace erelic {
+namespace {
+auto checked_size(std::size_t size) -> std::size_t {
+  if (!std::has_single_bit(size)) {
+    throw std::invalid_argument("edge coverage map size must be a non-zero power of two");
+  }
+  return size;
+}
+
+auto checked_bitmap(std::span<std::uint8_t> external) -> std::span<std::uint8_t, pc_coverage::bitmap_size> {
+  if (external.size() != pc_coverage::bitmap_size) {
+    throw std::invalid_argument("pc coverage bitmap must hold one bit per address");
+  }
+  return std::span<std::uint8_t, pc_coverage::bitmap_size>{external.data(), pc_coverage::bitmap_size};
+}
+}; // namespace
+
+pc_coverage::pc_coverage() : owned(bitmap_size), bits(owned.data(), bitmap_size) {}
+
+pc_coverage::pc_coverage(std::span<std::uint8_t> external) : bits(checked_bitmap(external)) {}
+
+
+auto pc_coverage::count() const noexcept -> std::size_t {
+  return std::accumulate(bits.begin(), bits.end(), std::size_t{0},
+                         [](std::size_t sum, std::uint8_t byte) { return sum + std::popcount(byte); });
+}
+
+void pc_coverage::reset() noexcept { std::ranges::fill(bits, std::uint8_t{0}); }
+
+edge_coverage::edge_coverage(std::size_t size) : owned(checked_size(size)), map(owned), mask(size - 1) {}
+
+edge_coverage::edge_coverage(std::span<std::uint8_t> external)
+    : map(external), mask(checked_size(external.size()) - 1) {}
+
+void edge_coverage::reset() noexcept {
+  std::ranges::fill(map, std::uint8_t{0});
+  previous = 0;
+}
+}; // namespace erelic
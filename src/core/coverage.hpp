@@ -0,0 +1,96 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "address.hpp"
+
+namespace erelic {
+// One bit per address of the 64 KiB space, set when an instruction is fetched from it. Bit `pc % 8` of byte `pc / 8`
+// belongs to `pc`, so the exported map does not depend on host endianness. Like `edge_coverage`, the bitmap is either
+// owned or attached to external memory a fuzzer reads directly.
+class pc_coverage {
+public:
+  static constexpr auto bitmap_size = address_space_size / 8;
+
+  pc_coverage();
+  // Does not take ownership; `external` must outlive this object. Throws `std::invalid_argument` unless it holds
+  // exactly `bitmap_size` bytes.
+  explicit pc_coverage(std::span<std::uint8_t> external);
+
+  pc_coverage(const pc_coverage &) = delete;
+  pc_coverage(pc_coverage &&) noexcept = default;
+  auto operator=(const pc_coverage &) -> pc_coverage & = delete;
+  auto operator=(pc_coverage &&) noexcept -> pc_coverage & = default;
+  ~pc_coverage() = default;
+
+  // Called from the fetch path; a single read-modify-write of one byte.
+  void mark(address pc) noexcept { bits[pc.raw >> 3U] |= static_cast<std::uint8_t>(1U << (pc.raw & 7U)); }
+
+  [[nodiscard]] auto executed(address pc) const noexcept -> bool {
+    return ((bits[pc.raw >> 3U] >> (pc.raw & 7U)) & 1U) != 0;
+  }
+  [[nodiscard]] auto count() const noexcept -> std::size_t;
+
+  void reset() noexcept;
+
+  // View of the live bitmap, valid for the lifetime of this object.
+  [[nodiscard]] auto raw() const noexcept -> std::span<const std::uint8_t, bitmap_size> { return bits; }
+
+private:
+  std::vector<std::uint8_t> owned;
+  std::span<std::uint8_t, bitmap_size> bits;
+};
+
+// AFL-style edge map: each fetch bumps the 8-bit counter at `hash(previous) >> 1 ^ hash(current)`, so both the
+// branch taken and its direction are recorded. The map is either owned or attached to external memory, e.g. the
+// shared memory region a fuzzer hands over, in which case the fuzzer reads it directly without copying.
+class edge_coverage {
+public:
+  static constexpr auto default_size = std::size_t{0x10000};
+
+  // Throws `std::invalid_argument` unless `size` is a non-zero power of two.
+  explicit edge_coverage(std::size_t size = default_size);
+  // Does not take ownership; `external` must outlive this object. Throws `std::invalid_argument` unless its size is a
+  // non-zero power of two.
+  explicit edge_coverage(std::span<std::uint8_t> external);
+
+  edge_coverage(const edge_coverage &) = delete;
+  edge_coverage(edge_coverage &&) noexcept = default;
+  auto operator=(const edge_coverage &) -> edge_coverage & = delete;
+  auto operator=(edge_coverage &&) noexcept -> edge_coverage & = default;
+  ~edge_coverage() = default;
+
+  // Called from the fetch path; a single increment of one counter.
+  void mark(address pc) noexcept {
+    const auto current = location_of(pc);
+    ++map[(current ^ previous) & mask];
+    previous = current >> 1U;
+  }
+
+  // Clears the counters and forgets the previous location, so the next run starts a fresh trace.
+  void reset() noexcept;
+  // Starts a fresh trace without clearing the counters.
+  void restart() noexcept { previous = 0; }
+
+  [[nodiscard]] auto raw() const noexcept -> std::span<const std::uint8_t> { return map; }
+
+private:
+  // Spreads neighbouring addresses across the map, standing in for AFL's random per-block ids.
+  static constexpr auto location_of(address pc) noexcept -> std::size_t {
+    return static_cast<std::size_t>((std::uint32_t{pc.raw} * 0x9E3779B1U) >> 16U);
+  }
+
+private:
+  std::vector<std::uint8_t> owned;
+  std::span<std::uint8_t> map;
+  std::size_t mask;
+  std::size_t previous = 0;
+};
+}; // namespace erelic
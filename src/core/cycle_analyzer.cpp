@@ -0,0 +1,285 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "cycle_analyzer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <queue>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "instruction.hpp"
+
+namespace erelic {
+namespace {
+constexpr auto unreached = std::numeric_limits<std::uint64_t>::max();
+
+// Whether an indexed access may cross a page. An absolute base at the start of a page never does.
+auto may_cross(const instruction &info, address_raw base) noexcept -> bool {
+  switch (info.mode) {
+    case address_mode::ABSX: [[fallthrough]];
+    case address_mode::ABSY: return (base & 0x00FFU) != 0;
+    case address_mode::INDY: return true;
+    default: return false;
+  }
+}
+
+void sort_unique(std::vector<address> &addresses) {
+  std::ranges::sort(addresses);
+  const auto [first, last] = std::ranges::unique(addresses);
+  addresses.erase(first, last);
+}
+}; // namespace
+
+auto operator<<(std::ostream &os, const cycle_report &r) -> std::ostream & {
+  os << r.entry << ": " << r.best << "..";
+  if (r.worst) {
+    os << *r.worst;
+  } else {
+    os << "unbounded";
+  }
+  os << " cycles, " << r.instructions << " instructions";
+  for (const auto &a : r.loops) {
+    os << "\n  loop at " << a;
+  }
+  for (const auto &a : r.unresolved) {
+    os << "\n  unresolved at " << a;
+  }
+  return os;
+}
+
+cycle_analyzer::cycle_analyzer(std::span<const std::byte> code, address origin, instruction_set set)
+    : code{code}, origin{origin.raw}, set{set}, table{&instruction_table_for(set)} {
+  if (origin.raw + code.size() > address_space_size) {
+    throw std::invalid_argument("code does not fit the address space");
+  }
+}
+
+auto cycle_analyzer::contains(address_raw a, std::size_t length) const noexcept -> bool {
+  return a >= origin && a - origin + length <= code.size();
+}
+
+auto cycle_analyzer::byte_at(address_raw a) const noexcept -> std::byte { return code[a - origin]; }
+
+auto cycle_analyzer::word_at(address_raw a) const noexcept -> address_raw {
+  return static_cast<address_raw>(std::to_integer<unsigned>(byte_at(a)) |
+                                  (std::to_integer<unsigned>(byte_at(static_cast<address_raw>(a + 1))) << 8U));
+}
+
+// The NMOS chip fetches the high byte of a vector at $xxFF from $xx00.
+auto cycle_analyzer::jump_vector(address_raw pointer) const noexcept -> std::optional<address_raw> {
+  const auto high = set == instruction_set::CMOS
+                      ? static_cast<address_raw>(pointer + 1)
+                      : static_cast<address_raw>((pointer & 0xFF00U) | ((pointer + 1U) & 0x00FFU));
+  if (!contains(pointer) || !contains(high)) {
+    return std::nullopt;
+  }
+  return static_cast<address_raw>(std::to_integer<unsigned>(byte_at(pointer)) |
+                                  (std::to_integer<unsigned>(byte_at(high)) << 8U));
+}
+
+auto cycle_analyzer::successors(address_raw pc, cycle_report &report) -> std::vector<edge> {
+  const auto &info = as_instruction(byte_at(pc), *table);
+  if (!contains(pc, info.length)) {
+    report.unresolved.emplace_back(pc);
+    return {{.to = std::nullopt, .best = info.cycles, .worst = info.cycles}};
+  }
+  const auto next = static_cast<address_raw>(pc + info.length);
+  const auto to = [&](address_raw target, std::uint64_t best, std::uint64_t worst) -> edge {
+    if (!contains(target)) {
+      report.unresolved.emplace_back(pc);
+      return {.to = std::nullopt, .best = best, .worst = worst};
+    }
+    return {.to = target, .best = best, .worst = worst};
+  };
+  const auto end = [&](bool resolved) -> std::vector<edge> {
+    if (!resolved) {
+      report.unresolved.emplace_back(pc);
+    }
+    return {{.to = std::nullopt, .best = info.cycles, .worst = info.cycles}};
+  };
+
+  switch (info.op) {
+    case mnemonic::JAM: report.loops.emplace_back(pc); return {};
+    case mnemonic::RTI: [[fallthrough]];
+    case mnemonic::RTS: return end(true);
+    case mnemonic::BRK: [[fallthrough]];
+    case mnemonic::STP: [[fallthrough]];
+    case mnemonic::WAI: return end(false);
+    case mnemonic::JMP: {
+      if (info.mode == address_mode::ABSL) {
+        return {to(word_at(static_cast<address_raw>(pc + 1)), info.cycles, info.cycles)};
+      }
+      const auto target = info.mode == address_mode::INDR ? jump_vector(word_at(static_cast<address_raw>(pc + 1)))
+                                                          : std::nullopt;
+      if (!target) {
+        return end(false);
+      }
+      return {to(*target, info.cycles, info.cycles)};
+    }
+    case mnemonic::JSR: {
+      const auto callee = word_at(static_cast<address_raw>(pc + 1));
+      if (!contains(callee)) {
+        report.unresolved.emplace_back(pc);
+        return {to(next, info.cycles, info.cycles)};
+      }
+      if (in_progress.contains(callee)) {
+        report.loops.emplace_back(pc);
+        return {to(next, info.cycles, info.cycles)};
+      }
+      const auto sub = analyze(address{callee});
+      if (!sub.worst) {
+        report.loops.emplace_back(pc);
+      }
+      report.unresolved.insert(report.unresolved.end(), sub.unresolved.begin(), sub.unresolved.end());
+      return {to(next, info.cycles + sub.best, info.cycles + sub.worst.value_or(sub.best))};
+    }
+    default: break;
+  }
+
+  if (info.mode == address_mode::RELA || info.mode == address_mode::ZPRL) {
+    const auto offset = static_cast<std::int8_t>(byte_at(static_cast<address_raw>(next - 1)));
+    const auto target = static_cast<address_raw>(next + offset);
+    const auto crossed = page_of(address{next}) != page_of(address{target});
+    const auto taken = cycles_with_penalty(info, crossed ? page_boundary::NEXT : page_boundary::SAME);
+    if (info.op == mnemonic::BRA) {
+      return {to(target, taken, taken)};
+    }
+    return {to(next, info.cycles, info.cycles), to(target, taken, taken)};
+  }
+
+  const auto base = info.length == 3 ? word_at(static_cast<address_raw>(pc + 1)) : address_raw{0};
+  const auto best = cycles_with_penalty(info, page_boundary::SAME);
+  const auto worst = may_cross(info, base) ? cycles_with_penalty(info, page_boundary::NEXT) : best;
+  return {to(next, best, worst)};
+}
+
+auto cycle_analyzer::analyze(address entry) -> cycle_report {
+  if (const auto found = reports.find(entry.raw); found != reports.end()) {
+    return found->second;
+  }
+
+  auto report = cycle_report{.entry = entry};
+  if (!contains(entry.raw)) {
+    report.worst = 0;
+    report.unresolved.push_back(entry);
+    return report;
+  }
+
+  in_progress.insert(entry.raw);
+  auto flow = graph{};
+  auto pending = std::vector<address_raw>{entry.raw};
+  while (!pending.empty()) {
+    const auto pc = pending.back();
+    pending.pop_back();
+    if (flow.contains(pc)) {
+      continue;
+    }
+    auto edges = successors(pc, report);
+    for (const auto &e : edges) {
+      if (e.to && !flow.contains(*e.to)) {
+        pending.push_back(*e.to);
+      }
+    }
+    flow.emplace(pc, std::move(edges));
+  }
+  in_progress.erase(entry.raw);
+  report.instructions = flow.size();
+
+  // Longest path over the acyclic graph; an edge back into the current path closes a loop. A post-order walk with an
+  // explicit stack, since a long straight-line routine would otherwise recurse once per instruction.
+  struct frame {
+    address_raw pc;
+    std::size_t next = 0;
+    std::uint64_t worst = 0;
+  };
+  auto longest = std::map<address_raw, std::uint64_t>{};
+  auto on_path = std::set<address_raw>{entry.raw};
+  auto path = std::vector<frame>{{.pc = entry.raw}};
+  while (!path.empty()) {
+    auto &top = path.back();
+    const auto &edges = flow.at(top.pc);
+    if (top.next == edges.size()) {
+      longest[top.pc] = top.worst;
+      on_path.erase(top.pc);
+      path.pop_back();
+      if (!path.empty()) {
+        auto &caller = path.back();
+        const auto &e = flow.at(caller.pc)[caller.next++];
+        caller.worst = std::max(caller.worst, e.worst + longest.at(*e.to));
+      }
+      continue;
+    }
+    const auto &e = edges[top.next];
+    if (!e.to) {
+      top.worst = std::max(top.worst, e.worst);
+      ++top.next;
+    } else if (on_path.contains(*e.to)) {
+      report.loops.emplace_back(top.pc);
+      ++top.next;
+    } else if (const auto found = longest.find(*e.to); found != longest.end()) {
+      top.worst = std::max(top.worst, e.worst + found->second);
+      ++top.next;
+    } else {
+      on_path.insert(*e.to);
+      path.push_back({.pc = *e.to});
+    }
+  }
+
+  // Shortest path to an end, with every edge costing at least one cycle.
+  auto distance = std::map<address_raw, std::uint64_t>{{entry.raw, 0}};
+  auto queue = std::priority_queue<std::pair<std::uint64_t, address_raw>,
+                                   std::vector<std::pair<std::uint64_t, address_raw>>, std::greater<>>{};
+  queue.emplace(0, entry.raw);
+  auto best = unreached;
+  while (!queue.empty()) {
+    const auto [d, pc] = queue.top();
+    queue.pop();
+    if (d != distance.at(pc)) {
+      continue;
+    }
+    for (const auto &e : flow.at(pc)) {
+      if (!e.to) {
+        best = std::min(best, d + e.best);
+        continue;
+      }
+      const auto [it, inserted] = distance.try_emplace(*e.to, d + e.best);
+      if (inserted || d + e.best < it->second) {
+        it->second = d + e.best;
+        queue.emplace(it->second, *e.to);
+      }
+    }
+  }
+
+  report.best = best == unreached ? 0 : best;
+  sort_unique(report.loops);
+  sort_unique(report.unresolved);
+  if (report.loops.empty()) {
+    report.worst = longest.at(entry.raw);
+  }
+  reports.emplace(entry.raw, report);
+  return report;
+}
+
+auto cycle_analyzer::analyze(std::span<const address> entries) -> std::vector<cycle_report> {
+  auto result = std::vector<cycle_report>{};
+  result.reserve(entries.size());
+  for (const auto &entry : entries) {
+    result.push_back(analyze(entry));
+  }
+  return result;
+}
+}; // namespace erelic
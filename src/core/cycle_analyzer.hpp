@@ -0,0 +1,73 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <set>
+#include <span>
+#include <vector>
+
+#include "address.hpp"
+#include "instruction.hpp"
+
+namespace erelic {
+// Static cycle bounds of a routine, over every path from its entry to an RTS or RTI. Subroutines are included with
+// their own bounds; page crossings count where they are statically known and in the worst case otherwise.
+struct cycle_report {
+  address entry;
+  // 0 if no path ends.
+  std::uint64_t best = 0;
+  // Absent if a loop, a recursion or a JAM makes the count unbounded.
+  std::optional<std::uint64_t> worst{};
+  std::size_t instructions = 0;
+  // Branches and jumps closing a loop, JSRs into an unbounded subroutine and JAMs.
+  std::vector<address> loops{};
+  // Instructions after which control is not statically known: indirect jumps without a vector in the region, BRK,
+  // WAI, STP and transfers out of the region. Their paths are counted up to and including them.
+  std::vector<address> unresolved{};
+};
+
+auto operator<<(std::ostream &os, const cycle_report &r) -> std::ostream &;
+
+// Builds the control-flow graph of routines in a ROM image and bounds their cycle counts, e.g. to prove an interrupt
+// handler or a raster routine fits its budget. Subroutine reports are cached across calls.
+class cycle_analyzer {
+public:
+  // `code` is the image mapped at `origin` and must outlive the analyzer. Throws `std::invalid_argument` if it does not
+  // fit the address space.
+  cycle_analyzer(std::span<const std::byte> code, address origin, instruction_set set);
+
+  [[nodiscard]] auto analyze(address entry) -> cycle_report;
+  [[nodiscard]] auto analyze(std::span<const address> entries) -> std::vector<cycle_report>;
+
+private:
+  struct edge {
+    // Absent for a path end.
+    std::optional<address_raw> to;
+    std::uint64_t best = 0;
+    std::uint64_t worst = 0;
+  };
+
+  using graph = std::map<address_raw, std::vector<edge>>;
+
+  [[nodiscard]] auto contains(address_raw a, std::size_t length = 1) const noexcept -> bool;
+  [[nodiscard]] auto byte_at(address_raw a) const noexcept -> std::byte;
+  [[nodiscard]] auto word_at(address_raw a) const noexcept -> address_raw;
+  [[nodiscard]] auto jump_vector(address_raw pointer) const noexcept -> std::optional<address_raw>;
+  auto successors(address_raw pc, cycle_report &report) -> std::vector<edge>;
+
+private:
+  std::span<const std::byte> code;
+  address_raw origin;
+  instruction_set set;
+  const instruction_table *table;
+  std::map<address_raw, cycle_report> reports;
+  std::set<address_raw> in_progress;
+};
+}; // namespace erelic
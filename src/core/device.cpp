@@ -2,17 +2,51 @@
 // Created by Kyrylo Rud on 05.05.2025.
 //
 
-#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <utility>
 
-#include "address.hpp"
 #include "device.hpp"
 
 namespace erelic {
-auto device::read(address absolute, address relative) const noexcept -> std::byte {
-  return impl->read(absolute, relative);
+device::device(const device &other) : read_fn{other.read_fn}, write_fn{other.write_fn}, ops{other.ops} {
+  ops->copy(other.storage.data(), storage.data());
 }
 
-auto device::write(address absolute, address relative, std::byte value) noexcept -> write_status {
-  return impl->write(absolute, relative, value);
+device::device(device &&other) noexcept : read_fn{other.read_fn}, write_fn{other.write_fn}, ops{other.ops} {
+  ops->move(other.storage.data(), storage.data());
+}
+
+auto device::operator=(const device &other) -> device & {
+  if (this != &other) {
+    auto copy = device{other};
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+auto device::operator=(device &&other) noexcept -> device & {
+  if (this != &other) {
+    ops->destroy(storage.data());
+    read_fn = other.read_fn;
+    write_fn = other.write_fn;
+    ops = other.ops;
+    ops->move(other.storage.data(), storage.data());
+  }
+  return *this;
+}
+
+device::~device() { ops->destroy(storage.data()); }
+
+void device::save_state(std::ostream &os) const { ops->save_state(storage.data(), os); }
+
+void device::load_state(std::istream &is) { ops->load_state(storage.data(), is); }
+
+auto device::memory() noexcept -> std::span<std::byte> { return ops->memory(storage.data()); }
+
+auto device::stable_until(address relative, std::uint64_t now) const noexcept -> std::uint64_t {
+  return ops->stable_until(storage.data(), relative, now);
 }
 }; // namespace erelic
@@ -4,9 +4,18 @@
 
 #pragma once
 
+#include <array>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
 #include <memory>
+#include <new>
 #include <ostream>
+#include <span>
+#include <type_traits>
+#include <utility>
 
 #include "address.hpp"
 
@@ -24,41 +33,207 @@ concept io_device = requires(const T dev, address a, address r) {
   { dev.write(a, r, v) } noexcept -> std::same_as<write_status>;
 };
 
+// Device with internal state beyond what is visible through its address range (latches, timers, banking). The state
+// is written and read back in the same device-defined binary layout.
+template <typename T>
+concept stateful_device = io_device<T> && requires(const T dev, T mut, std::ostream &os, std::istream &is) {
+  { dev.save_state(os) } -> std::same_as<void>;
+  { mut.load_state(is) } -> std::same_as<void>;
+};
+
+// Device that can tell how long reads of a register keep returning the same value without side effects, which lets
+// the core fast-forward polling loops over it. `stable_until` returns the first cycle at or after `now` at which a
+// read of `relative` may differ; returning `now` itself means the register must not be skipped over.
+template <typename T>
+concept pollable_device = io_device<T> && requires(const T dev, address r, std::uint64_t now) {
+  { dev.stable_until(r, now) } noexcept -> std::same_as<std::uint64_t>;
+};
+
+// Plain RAM: `read(a, r)` returns `memory()[r.raw]`, `write` stores into it and reports `write_status::WRITTEN`, with
+// no other side effects, so the CPU core may bypass dispatch and access `memory()` directly.
+template <typename T>
+concept memory_device = io_device<T> && requires(T dev) {
+  { dev.memory() } noexcept -> std::same_as<std::span<std::byte>>;
+};
+
+// Owning, type-erased device. Small implementations live in the inline buffer right next to the dispatch pointers,
+// larger ones are owned on the heap. Copies are deep; state is only shared when constructed from a `std::shared_ptr`.
+// An implementation taken by value must be copyable; one that cannot be copied is shared through a `std::shared_ptr`
+// or borrowed through `std::ref`. A device constructed from `std::ref` only borrows the implementation, which must then
+// outlive every copy. Copying a moved-from device gives another moved-from device.
 class device {
 public:
+  static constexpr std::size_t inline_size = 32;
+  static constexpr std::size_t inline_align = alignof(std::max_align_t);
+
   template <io_device T>
+    requires(!std::same_as<std::remove_cvref_t<T>, device>)
   explicit device(T &&impl);
 
   template <io_device T>
   explicit device(std::shared_ptr<T> ptr);
 
+  template <io_device T>
+  explicit device(std::reference_wrapper<T> ref) noexcept;
+
+  device(const device &other);
+  device(device &&other) noexcept;
+  auto operator=(const device &other) -> device &;
+  auto operator=(device &&other) noexcept -> device &;
+  ~device();
+
   [[nodiscard]] auto read(address absolute, address relative) const noexcept -> std::byte;
   [[nodiscard]] auto write(address absolute, address relative, std::byte value) noexcept -> write_status;
 
+  // No-ops unless the implementation is a `stateful_device`.
+  void save_state(std::ostream &os) const;
+  void load_state(std::istream &is);
+
+  // Empty unless the implementation is a `memory_device`.
+  [[nodiscard]] auto memory() noexcept -> std::span<std::byte>;
+
+  // Returns `now` unless the implementation is a `pollable_device`.
+  [[nodiscard]] auto stable_until(address relative, std::uint64_t now) const noexcept -> std::uint64_t;
+
+  template <typename T>
+  static constexpr bool stores_inline = sizeof(T) <= inline_size && alignof(T) <= inline_align &&
+                                        std::is_nothrow_move_constructible_v<T> && std::copy_constructible<T>;
+
 private:
-  struct idevice {
-    virtual ~idevice() = default;
-    virtual auto read(address, address) const noexcept -> std::byte = 0;
-    virtual auto write(address, address, std::byte) noexcept -> write_status = 0;
+  struct lifecycle {
+    void (*copy)(const void *from, void *to);
+    void (*move)(void *from, void *to) noexcept;
+    void (*destroy)(void *storage) noexcept;
+    void (*save_state)(const void *storage, std::ostream &os);
+    void (*load_state)(void *storage, std::istream &is);
+    auto (*stable_until)(const void *storage, address r, std::uint64_t now) noexcept -> std::uint64_t;
+    auto (*memory)(void *storage) noexcept -> std::span<std::byte>;
   };
 
-  template <typename T>
-  struct model : idevice {
-    T impl;
+  // `Handle` is what actually sits in the inline buffer: the implementation itself, or an owning, shared or borrowed
+  // pointer to it.
+  template <typename T, typename Handle>
+  struct model {
+    static auto handle(const void *storage) noexcept -> const Handle & {
+      return *std::launder(static_cast<const Handle *>(storage));
+    }
+    static auto handle(void *storage) noexcept -> Handle & { return *std::launder(static_cast<Handle *>(storage)); }
+
+    static auto object(const void *storage) noexcept -> const T & {
+      if constexpr (std::same_as<Handle, T>) {
+        return handle(storage);
+      } else {
+        return *handle(storage);
+      }
+    }
+    static auto object(void *storage) noexcept -> T & {
+      if constexpr (std::same_as<Handle, T>) {
+        return handle(storage);
+      } else {
+        return *handle(storage);
+      }
+    }
 
-    explicit model(T i) : impl(std::move(i)) {}
+    static auto read(const void *storage, address a, address r) noexcept -> std::byte {
+      return object(storage).read(a, r);
+    }
+    static auto write(void *storage, address a, address r, std::byte v) noexcept -> write_status {
+      return object(storage).write(a, r, v);
+    }
 
-    auto read(address a, address r) const noexcept -> std::byte override { return impl.read(a, r); }
-    auto write(address a, address r, std::byte v) noexcept -> write_status override { return impl.write(a, r, v); }
+    static void copy(const void *from, void *to) {
+      if constexpr (std::same_as<Handle, std::unique_ptr<T>>) {
+        const auto &owned = handle(from);
+        ::new (to) Handle(owned ? std::make_unique<T>(*owned) : nullptr);
+      } else {
+        ::new (to) Handle(handle(from));
+      }
+    }
+    static void move(void *from, void *to) noexcept { ::new (to) Handle(std::move(handle(from))); }
+    static void destroy(void *storage) noexcept { std::destroy_at(&handle(storage)); }
+    static void save_state(const void *storage, std::ostream &os) {
+      if constexpr (stateful_device<T>) {
+        object(storage).save_state(os);
+      }
+    }
+    static void load_state(void *storage, std::istream &is) {
+      if constexpr (stateful_device<T>) {
+        object(storage).load_state(is);
+      }
+    }
+
+    static auto stable_until(const void *storage, address r, std::uint64_t now) noexcept -> std::uint64_t {
+      if constexpr (pollable_device<T>) {
+        return object(storage).stable_until(r, now);
+      } else {
+        return now;
+      }
+    }
+
+    static auto memory(void *storage) noexcept -> std::span<std::byte> {
+      if constexpr (memory_device<T>) {
+        return object(storage).memory();
+      } else {
+        return {};
+      }
+    }
+
+    static constexpr auto ops = lifecycle{&copy, &move, &destroy, &save_state, &load_state, &stable_until, &memory};
   };
 
+  template <typename T>
+  using handle_for = std::conditional_t<stores_inline<T>, T, std::unique_ptr<T>>;
+
+  template <typename T, typename Handle>
+  void emplace(Handle &&handle);
+
 private:
-  std::shared_ptr<idevice> impl;
+  auto (*read_fn)(const void *, address, address) noexcept -> std::byte = nullptr;
+  auto (*write_fn)(void *, address, address, std::byte) noexcept -> write_status = nullptr;
+  const lifecycle *ops = nullptr;
+  alignas(inline_align) std::array<std::byte, inline_size> storage{};
 };
 
+static_assert(sizeof(std::shared_ptr<void>) <= device::inline_size);
+
+template <typename T, typename Handle>
+void device::emplace(Handle &&handle) {
+  using model_type = model<T, std::remove_cvref_t<Handle>>;
+  ::new (storage.data()) std::remove_cvref_t<Handle>(std::forward<Handle>(handle));
+  read_fn = &model_type::read;
+  write_fn = &model_type::write;
+  ops = &model_type::ops;
+}
+
 template <io_device T>
-device::device(T &&impl) : impl{std::make_shared<model<std::decay_t<T>>>(std::forward<T>(impl))} {}
+  requires(!std::same_as<std::remove_cvref_t<T>, device>)
+device::device(T &&impl) {
+  using type = std::decay_t<T>;
+  static_assert(std::copy_constructible<type>,
+                "device: copies are deep, so the implementation must be copyable; pass a std::shared_ptr to share it "
+                "or std::ref to borrow it");
+  if constexpr (std::same_as<handle_for<type>, type>) {
+    emplace<type>(type(std::forward<T>(impl)));
+  } else {
+    emplace<type>(std::make_unique<type>(std::forward<T>(impl)));
+  }
+}
 
 template <io_device T>
-device::device(std::shared_ptr<T> ptr) : impl{ptr} {}
+device::device(std::shared_ptr<T> ptr) {
+  emplace<T>(std::move(ptr));
+}
+
+template <io_device T>
+device::device(std::reference_wrapper<T> ref) noexcept {
+  emplace<T>(&ref.get());
+}
+
+inline auto device::read(address absolute, address relative) const noexcept -> std::byte {
+  return read_fn(storage.data(), absolute, relative);
+}
+
+inline auto device::write(address absolute, address relative, std::byte value) noexcept -> write_status {
+  return write_fn(storage.data(), absolute, relative, value);
+}
 }; // namespace erelic
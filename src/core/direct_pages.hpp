@@ -0,0 +1,75 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+
+namespace erelic {
+// Bus that can hand out direct pointers to pages backed by a `memory_device`.
+template <typename T>
+concept page_binding_bus = io_bus<T> && requires(T bus, std::size_t page) {
+  { bus.bind_page(page) } noexcept -> std::same_as<std::span<std::byte>>;
+};
+
+constexpr auto zero_page = std::size_t{0x00};
+constexpr auto stack_page = std::size_t{0x01};
+
+// Zero page and stack page accessors for the CPU core. Both pages are bound once at construction; when the memory
+// map backs a page with plain RAM, accesses index the bound page by the 8-bit offset, skipping `address` construction
+// and device dispatch. Otherwise they fall back to the bus. Construct after the memory map is complete.
+template <io_bus Bus>
+class direct_pages {
+public:
+  explicit direct_pages(Bus &bus) noexcept : bus{&bus} {
+    if constexpr (page_binding_bus<Bus>) {
+      zero = bus.bind_page(zero_page);
+      stack = bus.bind_page(stack_page);
+    }
+  }
+
+  [[nodiscard]] auto read_zero_page(std::uint8_t offset) const noexcept -> std::byte {
+    return !zero.empty() ? zero[offset] : bus->read(address{offset});
+  }
+  auto write_zero_page(std::uint8_t offset, std::byte value) noexcept -> write_status {
+    if (!zero.empty()) {
+      zero[offset] = value;
+      return write_status::WRITTEN;
+    }
+    return bus->write(address{offset}, value);
+  }
+  // Little-endian pointer at `offset`, wrapping within the zero page as `(zp,X)` and `(zp),Y` do.
+  [[nodiscard]] auto read_zero_page_word(std::uint8_t offset) const noexcept -> address_raw {
+    const auto lo = std::to_integer<address_raw>(read_zero_page(offset));
+    const auto hi = std::to_integer<address_raw>(read_zero_page(static_cast<std::uint8_t>(offset + 1)));
+    return static_cast<address_raw>(lo | (hi << 8U));
+  }
+
+  [[nodiscard]] auto read_stack(std::uint8_t s) const noexcept -> std::byte {
+    return !stack.empty() ? stack[s] : bus->read(address{static_cast<address_raw>(stack_page * page_size + s)});
+  }
+  auto write_stack(std::uint8_t s, std::byte value) noexcept -> write_status {
+    if (!stack.empty()) {
+      stack[s] = value;
+      return write_status::WRITTEN;
+    }
+    return bus->write(address{static_cast<address_raw>(stack_page * page_size + s)}, value);
+  }
+
+  [[nodiscard]] auto zero_page_direct() const noexcept -> bool { return !zero.empty(); }
+  [[nodiscard]] auto stack_direct() const noexcept -> bool { return !stack.empty(); }
+
+private:
+  Bus *bus;
+  std::span<std::byte> zero;
+  std::span<std::byte> stack;
+};
+}; // namespace erelic
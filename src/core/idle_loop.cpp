@@ -0,0 +1,69 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "idle_loop.hpp"
+
+#include <ostream>
+
+namespace erelic {
+auto operator<<(std::ostream &os, const loop_role &r) -> std::ostream & {
+  switch (r) {
+    case loop_role::BUSY: os << "BUSY"; break;
+    case loop_role::PURE: os << "PURE"; break;
+    case loop_role::POLL: os << "POLL"; break;
+    case loop_role::BRCH: os << "BRCH"; break;
+    case loop_role::PLBR: os << "PLBR"; break;
+    case loop_role::JUMP: os << "JUMP"; break;
+  }
+  return os;
+}
+
+auto loop_role_of(const instruction &info) noexcept -> loop_role {
+  switch (info.op) {
+    case mnemonic::AND: [[fallthrough]];
+    case mnemonic::BIT: [[fallthrough]];
+    case mnemonic::CMP: [[fallthrough]];
+    case mnemonic::CPX: [[fallthrough]];
+    case mnemonic::CPY: [[fallthrough]];
+    case mnemonic::LDA: [[fallthrough]];
+    case mnemonic::LDX: [[fallthrough]];
+    case mnemonic::LDY: [[fallthrough]];
+    case mnemonic::ORA:
+      switch (info.mode) {
+        case address_mode::IMME: return loop_role::PURE;
+        case address_mode::ABSL: [[fallthrough]];
+        case address_mode::ZPAG: return loop_role::POLL;
+        default: return loop_role::BUSY;
+      }
+    case mnemonic::NOP: return info.mode == address_mode::IMPL ? loop_role::PURE : loop_role::BUSY;
+    case mnemonic::BCC: [[fallthrough]];
+    case mnemonic::BCS: [[fallthrough]];
+    case mnemonic::BEQ: [[fallthrough]];
+    case mnemonic::BMI: [[fallthrough]];
+    case mnemonic::BNE: [[fallthrough]];
+    case mnemonic::BPL: [[fallthrough]];
+    case mnemonic::BRA: [[fallthrough]];
+    case mnemonic::BVC: [[fallthrough]];
+    case mnemonic::BVS: return loop_role::BRCH;
+    case mnemonic::BBR0: [[fallthrough]];
+    case mnemonic::BBR1: [[fallthrough]];
+    case mnemonic::BBR2: [[fallthrough]];
+    case mnemonic::BBR3: [[fallthrough]];
+    case mnemonic::BBR4: [[fallthrough]];
+    case mnemonic::BBR5: [[fallthrough]];
+    case mnemonic::BBR6: [[fallthrough]];
+    case mnemonic::BBR7: [[fallthrough]];
+    case mnemonic::BBS0: [[fallthrough]];
+    case mnemonic::BBS1: [[fallthrough]];
+    case mnemonic::BBS2: [[fallthrough]];
+    case mnemonic::BBS3: [[fallthrough]];
+    case mnemonic::BBS4: [[fallthrough]];
+    case mnemonic::BBS5: [[fallthrough]];
+    case mnemonic::BBS6: [[fallthrough]];
+    case mnemonic::BBS7: return loop_role::PLBR;
+    case mnemonic::JMP: return info.mode == address_mode::ABSL ? loop_role::JUMP : loop_role::BUSY;
+    default: return loop_role::BUSY;
+  }
+}
+}; // namespace erelic
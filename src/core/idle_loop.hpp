@@ -0,0 +1,173 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <utility>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "instruction.hpp"
+
+namespace erelic {
+// Bus that can report how long reads stay stable, see `pollable_device`.
+template <typename T>
+concept pollable_bus = io_bus<T> && requires(const T bus, address a, std::uint64_t now) {
+  { bus.stable_until(a, now) } noexcept -> std::same_as<std::uint64_t>;
+};
+
+// What an instruction may do inside an idle loop. Only instructions whose effect on registers and flags is idempotent
+// for unchanged memory are allowed, so every iteration after the first leaves the machine in the same state.
+enum class loop_role {
+  BUSY, // writes memory, accumulates state or has an address that depends on registers
+  PURE, // no memory access
+  POLL, // reads the absolute or zero page operand
+  BRCH, // conditional or unconditional relative branch
+  PLBR, // reads the zero page operand and branches on one of its bits
+  JUMP, // absolute jump
+};
+
+auto operator<<(std::ostream &os, const loop_role &r) -> std::ostream &;
+
+[[nodiscard]] auto loop_role_of(const instruction &info) noexcept -> loop_role;
+
+// Side-effect-free polling loop closed by the backward branch or jump at `branch`.
+struct idle_loop {
+  static constexpr std::size_t max_instructions = 8;
+  static constexpr std::size_t max_polled = 4;
+
+  address start;
+  address branch;
+  // Exact cost of one iteration that stays in the loop: every exit branch not taken, the closing branch taken.
+  std::uint64_t cycles_per_iteration = 0;
+  std::array<address_raw, max_polled> polled{};
+  std::size_t polled_count = 0;
+};
+
+// Decodes the loop closed by the instruction at `branch` if that instruction transfers control backwards and the body
+// is a straight run of at most `idle_loop::max_instructions` idle-safe instructions ending exactly at `branch`. Forward
+// branches are allowed only if they leave the loop.
+template <io_bus Bus>
+[[nodiscard]] auto find_idle_loop(const Bus &bus, const instruction_table &table, address branch)
+  -> std::optional<idle_loop> {
+  const auto byte_at = [&](address_raw a) { return std::to_integer<address_raw>(bus.read(address{a})); };
+  const auto word_at = [&](address_raw a) {
+    return static_cast<address_raw>(byte_at(a) | (byte_at(static_cast<address_raw>(a + 1)) << 8U));
+  };
+  const auto relative_target = [&](address_raw pc, const instruction &info) {
+    const auto next = static_cast<address_raw>(pc + info.length);
+    const auto offset = static_cast<std::int8_t>(byte_at(static_cast<address_raw>(next - 1)));
+    return static_cast<address_raw>(next + offset);
+  };
+  const auto target_of = [&](address_raw pc, const instruction &info) {
+    return loop_role_of(info) == loop_role::JUMP ? word_at(static_cast<address_raw>(pc + 1))
+                                                 : relative_target(pc, info);
+  };
+
+  const auto &closing = as_instruction(bus.read(branch), table);
+  const auto closing_role = loop_role_of(closing);
+  if (closing_role != loop_role::BRCH && closing_role != loop_role::PLBR && closing_role != loop_role::JUMP) {
+    return std::nullopt;
+  }
+  const auto start = target_of(branch.raw, closing);
+  if (start > branch.raw) {
+    return std::nullopt;
+  }
+
+  auto loop = idle_loop{.start = address{start}, .branch = branch};
+  auto pc = start;
+  for (std::size_t count = 0; count < idle_loop::max_instructions && pc <= branch.raw; ++count) {
+    const auto &info = as_instruction(bus.read(address{pc}), table);
+    const auto role = loop_role_of(info);
+    const auto closes = pc == branch.raw;
+    const auto next = static_cast<address_raw>(pc + info.length);
+
+    if (role == loop_role::BUSY || (role == loop_role::JUMP && !closes)) {
+      return std::nullopt;
+    }
+    if (role == loop_role::POLL || role == loop_role::PLBR) {
+      if (loop.polled_count == idle_loop::max_polled) {
+        return std::nullopt;
+      }
+      const auto operand = info.mode == address_mode::ABSL ? word_at(static_cast<address_raw>(pc + 1))
+                                                           : byte_at(static_cast<address_raw>(pc + 1));
+      loop.polled[loop.polled_count++] = operand;
+    }
+
+    if (closes) {
+      const auto crossed = role != loop_role::JUMP && page_of(address{next}) != page_of(address{start});
+      loop.cycles_per_iteration += cycles_with_penalty(info, crossed ? page_boundary::NEXT : page_boundary::SAME);
+      return loop;
+    }
+    if (role == loop_role::BRCH || role == loop_role::PLBR) {
+      const auto target = relative_target(pc, info);
+      if (info.op == mnemonic::BRA || (start <= target && target <= branch.raw)) {
+        return std::nullopt;
+      }
+    }
+    loop.cycles_per_iteration += info.cycles;
+    pc = next;
+  }
+  return std::nullopt;
+}
+
+// Fast-forwards idle loops in whole iterations. The core reports every taken backward branch or jump; once the same
+// loop was seen completing one full iteration, the skipper returns how many cycles the core may add to its counter
+// instead of executing further iterations. Registers, flags and PC are left as they are: they are a fixed point of
+// the loop as long as the polled registers stay stable and no event fires.
+class idle_skipper {
+public:
+  explicit idle_skipper(const instruction_table &table) noexcept : table{&table} {}
+
+  // `now` is the cycle count right after the branch, `next_event` the cycle of the next scheduled event (interrupt,
+  // timer, frame end). Returns a multiple of the loop's iteration cost that never reaches past `next_event` or the
+  // cycle any polled register may change.
+  template <pollable_bus Bus>
+  [[nodiscard]] auto on_backward_branch(const Bus &bus, address branch, std::uint64_t now, std::uint64_t next_event)
+    -> std::uint64_t {
+    if (analyzed != branch) {
+      analyzed = branch;
+      loop = find_idle_loop(bus, *table, branch);
+      arrived = now;
+      return 0;
+    }
+    if (!loop) {
+      return 0;
+    }
+
+    const auto previous = std::exchange(arrived, now);
+    if (now - previous != loop->cycles_per_iteration) {
+      return 0;
+    }
+
+    auto limit = next_event;
+    for (std::size_t i = 0; i < loop->polled_count; ++i) {
+      limit = std::min(limit, bus.stable_until(address{loop->polled[i]}, previous));
+    }
+    if (limit <= now) {
+      return 0;
+    }
+
+    const auto skipped = (limit - now) / loop->cycles_per_iteration * loop->cycles_per_iteration;
+    arrived += skipped;
+    return skipped;
+  }
+
+  // Forgets the analyzed loop; call after code may have been modified.
+  void reset() noexcept { analyzed.reset(); }
+
+private:
+  const instruction_table *table;
+  std::optional<address> analyzed;
+  std::optional<idle_loop> loop;
+  std::uint64_t arrived = 0;
+};
+}; // namespace erelic
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <ostream>
 
@@ -16,6 +17,22 @@ enum class mnemonic {
   ANE,
   ARR,
   ASL,
+  BBR0,
+  BBR1,
+  BBR2,
+  BBR3,
+  BBR4,
+  BBR5,
+  BBR6,
+  BBR7,
+  BBS0,
+  BBS1,
+  BBS2,
+  BBS3,
+  BBS4,
+  BBS5,
+  BBS6,
+  BBS7,
   BCC,
   BCS,
   BEQ,
@@ -23,6 +40,7 @@ enum class mnemonic {
   BMI,
   BNE,
   BPL,
+  BRA,
   BRK,
   BVC,
   BVS,
@@ -56,9 +74,21 @@ enum class mnemonic {
   ORA,
   PHA,
   PHP,
+  PHX,
+  PHY,
   PLA,
   PLP,
+  PLX,
+  PLY,
   RLA,
+  RMB0,
+  RMB1,
+  RMB2,
+  RMB3,
+  RMB4,
+  RMB5,
+  RMB6,
+  RMB7,
   ROL,
   ROR,
   RRA,
@@ -74,17 +104,30 @@ enum class mnemonic {
   SHX,
   SHY,
   SLO,
+  SMB0,
+  SMB1,
+  SMB2,
+  SMB3,
+  SMB4,
+  SMB5,
+  SMB6,
+  SMB7,
   SRE,
   STA,
+  STP,
   STX,
   STY,
+  STZ,
   TAS,
   TAX,
   TAY,
+  TRB,
+  TSB,
   TSX,
   TXA,
   TXS,
   TYA,
+  WAI,
 };
 
 auto operator<<(std::ostream &os, const mnemonic &m) -> std::ostream &;
@@ -96,6 +139,7 @@ enum class address_mode {
   ACCU,
   IMME,
   IMPL,
+  INAX,
   INDR,
   INDX,
   INDY,
@@ -103,6 +147,8 @@ enum class address_mode {
   ZPAG,
   ZPAX,
   ZPAY,
+  ZPIN,
+  ZPRL,
 };
 
 auto operator<<(std::ostream &os, const address_mode &m) -> std::ostream &;
@@ -110,6 +156,7 @@ auto operator<<(std::ostream &os, const address_mode &m) -> std::ostream &;
 enum class instruction_set {
   STND,
   NMOS,
+  CMOS,
 };
 
 auto operator<<(std::ostream &os, const instruction_set &s) -> std::ostream &;
@@ -132,6 +179,67 @@ enum class page_boundary {
   NEXT,
 };
 
+using instruction_table = std::array<instruction, 256>;
+
+// Decode table of `set`. Look it up once per CPU instance and decode through the table overload of `as_instruction`.
+[[nodiscard]] auto instruction_table_for(instruction_set set) noexcept -> const instruction_table &;
+
+[[nodiscard]] constexpr auto as_instruction(std::byte byte, const instruction_table &table) noexcept
+  -> const instruction & {
+  return table[std::to_integer<std::size_t>(byte)];
+}
+
 [[nodiscard]] auto as_instruction(std::byte byte, instruction_set set) noexcept -> instruction;
-[[nodiscard]] auto cycles_with_penalty(const instruction &info, page_boundary page_relation) noexcept -> size_t;
+
+[[nodiscard]] constexpr auto cycles_with_penalty(const instruction &info, page_boundary page_relation) noexcept
+  -> size_t {
+  if (info.mode != address_mode::ABSX && info.mode != address_mode::ABSY && info.mode != address_mode::INDY &&
+      info.mode != address_mode::RELA && info.mode != address_mode::ZPRL) {
+    return info.cycles;
+  }
+
+  switch (info.op) {
+    case mnemonic::ASL: [[fallthrough]];
+    case mnemonic::LSR: [[fallthrough]];
+    case mnemonic::ROL: [[fallthrough]];
+    case mnemonic::ROR:
+      return info.set == instruction_set::CMOS && page_boundary::NEXT == page_relation ? info.cycles + 1 : info.cycles;
+    case mnemonic::ADC: [[fallthrough]];
+    case mnemonic::AND: [[fallthrough]];
+    case mnemonic::BIT: [[fallthrough]];
+    case mnemonic::BRA: [[fallthrough]];
+    case mnemonic::CMP: [[fallthrough]];
+    case mnemonic::EOR: [[fallthrough]];
+    case mnemonic::LDA: [[fallthrough]];
+    case mnemonic::LDX: [[fallthrough]];
+    case mnemonic::LDY: [[fallthrough]];
+    case mnemonic::ORA: [[fallthrough]];
+    case mnemonic::SBC: return page_boundary::NEXT == page_relation ? info.cycles + 1 : info.cycles;
+    case mnemonic::BBR0: [[fallthrough]];
+    case mnemonic::BBR1: [[fallthrough]];
+    case mnemonic::BBR2: [[fallthrough]];
+    case mnemonic::BBR3: [[fallthrough]];
+    case mnemonic::BBR4: [[fallthrough]];
+    case mnemonic::BBR5: [[fallthrough]];
+    case mnemonic::BBR6: [[fallthrough]];
+    case mnemonic::BBR7: [[fallthrough]];
+    case mnemonic::BBS0: [[fallthrough]];
+    case mnemonic::BBS1: [[fallthrough]];
+    case mnemonic::BBS2: [[fallthrough]];
+    case mnemonic::BBS3: [[fallthrough]];
+    case mnemonic::BBS4: [[fallthrough]];
+    case mnemonic::BBS5: [[fallthrough]];
+    case mnemonic::BBS6: [[fallthrough]];
+    case mnemonic::BBS7: [[fallthrough]];
+    case mnemonic::BCC: [[fallthrough]];
+    case mnemonic::BCS: [[fallthrough]];
+    case mnemonic::BEQ: [[fallthrough]];
+    case mnemonic::BMI: [[fallthrough]];
+    case mnemonic::BNE: [[fallthrough]];
+    case mnemonic::BPL: [[fallthrough]];
+    case mnemonic::BVC: [[fallthrough]];
+    case mnemonic::BVS: return page_boundary::NEXT == page_relation ? info.cycles + 2 : info.cycles + 1;
+    default: return info.cycles;
+  }
+}
 }; // namespace erelic
@@ -0,0 +1,60 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "machine_arena.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+
+namespace erelic {
+machine_arena::machine_arena(std::size_t capacity) : block(capacity) {}
+
+machine_arena::~machine_arena() { reset(); }
+
+auto machine_arena::bytes(std::size_t size, std::size_t alignment) -> std::span<std::byte> {
+  auto result = std::span{static_cast<std::byte *>(allocate(size, alignment)), size};
+  std::ranges::fill(result, std::byte{0x00});
+  return result;
+}
+
+void machine_arena::reset() noexcept {
+  for (auto *c = cleanups; c != nullptr; c = c->next) {
+    c->destroy(c->object);
+  }
+  cleanups = nullptr;
+  offset = 0;
+}
+
+auto machine_arena::used() const noexcept -> std::size_t { return offset; }
+
+auto machine_arena::capacity() const noexcept -> std::size_t { return block.size(); }
+
+auto machine_arena::owns(const void *p) const noexcept -> bool {
+  const auto *begin = block.data();
+  const auto *end = std::next(begin, static_cast<std::ptrdiff_t>(block.size()));
+  return std::less_equal<>{}(begin, p) && std::less<>{}(p, end);
+}
+
+auto machine_arena::do_allocate(std::size_t size, std::size_t alignment) -> void * {
+  auto space = block.size() - offset;
+  auto *p = static_cast<void *>(std::next(block.data(), static_cast<std::ptrdiff_t>(offset)));
+  if (std::align(alignment, size, p, space) == nullptr) {
+    throw std::bad_alloc();
+  }
+  offset = block.size() - space + size;
+  return p;
+}
+
+void machine_arena::do_deallocate(void *, std::size_t, std::size_t) {}
+
+auto machine_arena::do_is_equal(const std::pmr::memory_resource &other) const noexcept -> bool {
+  return this == &other;
+}
+}; // namespace erelic
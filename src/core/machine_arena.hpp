@@ -0,0 +1,136 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+#include "registers.hpp"
+
+namespace erelic {
+// One contiguous block every part of a machine is placed into with a bump pointer. Objects created with `create` are
+// destroyed in reverse order by `reset` or by the arena's destructor; memory is never returned piecemeal, so tearing a
+// machine down is one pass over its destructors and resetting the arena makes the whole block reusable. Throws
+// `std::bad_alloc` once the block is exhausted. Also usable as a `std::pmr::memory_resource` for containers that
+// should live in the block.
+class machine_arena final : public std::pmr::memory_resource {
+public:
+  explicit machine_arena(std::size_t capacity);
+
+  machine_arena(const machine_arena &) = delete;
+  machine_arena(machine_arena &&) = delete;
+  auto operator=(const machine_arena &) -> machine_arena & = delete;
+  auto operator=(machine_arena &&) -> machine_arena & = delete;
+  ~machine_arena() override;
+
+  template <typename T, typename... Args>
+  auto create(Args &&...args) -> T &;
+
+  // Zero-filled bytes owned by the arena, e.g. RAM backing.
+  [[nodiscard]] auto bytes(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) -> std::span<std::byte>;
+
+  // Destroys every created object, newest first, and rewinds to an empty block.
+  void reset() noexcept;
+
+  [[nodiscard]] auto used() const noexcept -> std::size_t;
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t;
+  [[nodiscard]] auto owns(const void *p) const noexcept -> bool;
+
+private:
+  struct cleanup {
+    void (*destroy)(void *object) noexcept;
+    void *object;
+    cleanup *next;
+  };
+
+  auto do_allocate(std::size_t size, std::size_t alignment) -> void * override;
+  void do_deallocate(void *p, std::size_t size, std::size_t alignment) override;
+  [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource &other) const noexcept -> bool override;
+
+private:
+  std::vector<std::byte> block;
+  std::size_t offset = 0;
+  cleanup *cleanups = nullptr;
+};
+
+template <typename T, typename... Args>
+auto machine_arena::create(Args &&...args) -> T & {
+  if constexpr (std::is_trivially_destructible_v<T>) {
+    return *::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  } else {
+    // The cleanup record is taken first, so running out of space never leaves a constructed object unregistered.
+    auto *record = allocate(sizeof(cleanup), alignof(cleanup));
+    auto *object = ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    cleanups = ::new (record) cleanup{[](void *o) noexcept { std::destroy_at(static_cast<T *>(o)); }, object, cleanups};
+    return *object;
+  }
+}
+
+// Plain RAM over storage owned elsewhere, typically `machine_arena::bytes`. The storage must cover the mapped range.
+class ram_view {
+public:
+  explicit ram_view(std::span<std::byte> storage) noexcept : storage{storage} {}
+
+  [[nodiscard]] auto read(address, address relative) const noexcept -> std::byte {
+    return storage[relative.raw];
+  }
+  [[nodiscard]] auto write(address, address relative, std::byte value) noexcept -> write_status {
+    storage[relative.raw] = value;
+    return write_status::WRITTEN;
+  }
+  [[nodiscard]] auto memory() noexcept -> std::span<std::byte> { return storage; }
+  [[nodiscard]] auto stable_until(address, std::uint64_t) const noexcept -> std::uint64_t {
+    return std::numeric_limits<std::uint64_t>::max();
+  }
+
+private:
+  std::span<std::byte> storage;
+};
+
+// CPU state and memory map of one machine, with the page table allocated from the arena the machine lives in.
+struct machine {
+  explicit machine(machine_arena &arena) : arena{&arena}, memory{&arena} {}
+
+  machine_arena *arena;
+  registers cpu;
+  bus memory;
+};
+
+// Places a machine and everything mapped into it in `arena`, which must outlive the machine.
+class machine_builder {
+public:
+  explicit machine_builder(machine_arena &arena) : target{&arena.create<machine>(arena)} {}
+
+  // Constructs the device in the arena and maps it; the bus only borrows it.
+  template <io_device T, typename... Args>
+  auto map(address_range range, Args &&...args) -> T & {
+    auto &impl = target->arena->create<T>(std::forward<Args>(args)...);
+    target->memory.map(range, device{std::ref(impl)});
+    return impl;
+  }
+
+  // Maps zero-filled arena memory as RAM over `range`.
+  auto ram(address_range range) -> std::span<std::byte> {
+    return map<ram_view>(range, target->arena->bytes(range.size())).memory();
+  }
+
+  [[nodiscard]] auto build() const noexcept -> machine & { return *target; }
+
+private:
+  machine *target;
+};
+}; // namespace erelic
@@ -0,0 +1,65 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "mapped_file.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace erelic {
+namespace {
+[[noreturn]] void throw_errno(const char *what) { throw std::system_error(errno, std::generic_category(), what); }
+}; // namespace
+
+mapped_file::mapped_file(const std::filesystem::path &path) {
+  const auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw_errno("mapped_file: open");
+  }
+  struct stat info {};
+  if (fstat(fd, &info) != 0) {
+    const auto error = errno;
+    close(fd);
+    throw std::system_error(error, std::generic_category(), "mapped_file: stat");
+  }
+  size = static_cast<std::size_t>(info.st_size);
+  if (size == 0) {
+    close(fd);
+    return;
+  }
+  auto *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  const auto error = errno;
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::system_error(error, std::generic_category(), "mapped_file: mmap");
+  }
+  madvise(mapping, size, MADV_SEQUENTIAL);
+  data = static_cast<char *>(mapping);
+}
+
+mapped_file::mapped_file(mapped_file &&o) noexcept
+    : data{std::exchange(o.data, nullptr)}, size{std::exchange(o.size, 0)} {}
+
+auto mapped_file::operator=(mapped_file &&o) noexcept -> mapped_file & {
+  if (this != &o) {
+    std::swap(data, o.data);
+    std::swap(size, o.size);
+  }
+  return *this;
+}
+
+mapped_file::~mapped_file() {
+  if (data != nullptr) {
+    munmap(data, size);
+  }
+}
+}; // namespace erelic
@@ -0,0 +1,33 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace erelic {
+// Read-only memory mapping of a whole file, paged in by the kernel on access, so files larger than RAM can be scanned.
+// The mapping is advised for sequential reading. Throws `std::system_error` if the file cannot be opened or mapped.
+class mapped_file {
+public:
+  explicit mapped_file(const std::filesystem::path &path);
+  mapped_file(const mapped_file &) = delete;
+  mapped_file(mapped_file &&o) noexcept;
+  auto operator=(const mapped_file &) -> mapped_file & = delete;
+  auto operator=(mapped_file &&o) noexcept -> mapped_file &;
+  ~mapped_file();
+
+  [[nodiscard]] auto bytes() const noexcept -> std::span<const std::byte> {
+    return std::as_bytes(std::span<const char>{data, size});
+  }
+  [[nodiscard]] auto text() const noexcept -> std::string_view { return {data, size}; }
+
+private:
+  char *data = nullptr;
+  std::size_t size = 0;
+};
+}; // namespace erelic
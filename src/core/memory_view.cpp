@@ -0,0 +1,87 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "memory_view.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+namespace erelic {
+namespace {
+auto pack(const registers &cpu) noexcept -> std::uint64_t {
+  return std::to_integer<std::uint64_t>(cpu.a) | (std::to_integer<std::uint64_t>(cpu.x) << 8U) |
+         (std::to_integer<std::uint64_t>(cpu.y) << 16U) | (std::to_integer<std::uint64_t>(cpu.s) << 24U) |
+         (std::to_integer<std::uint64_t>(cpu.p) << 32U) | (std::uint64_t{cpu.pc.raw} << 40U);
+}
+
+auto unpack(std::uint64_t cell) noexcept -> registers {
+  const auto byte_at = [cell](unsigned shift) { return static_cast<std::byte>((cell >> shift) & 0xFFU); };
+  return {.a = byte_at(0),
+          .x = byte_at(8),
+          .y = byte_at(16),
+          .s = byte_at(24),
+          .p = byte_at(32),
+          .pc = address{static_cast<address_raw>(cell >> 40U)}};
+}
+}; // namespace
+
+memory_view::memory_view() : cpu_cell{pack(registers{})}, cells(address_space_size / cell_size) {
+  published.fill(std::numeric_limits<std::uint64_t>::max());
+}
+
+void memory_view::publish(const registers &cpu, std::uint64_t cycle, bus &b) noexcept {
+  const auto seq = sequence.load(std::memory_order_relaxed);
+  sequence.store(seq + 1, std::memory_order_relaxed);
+
+  cpu_cell.store(pack(cpu), std::memory_order_release);
+  cycle_cell.store(cycle, std::memory_order_release);
+  const auto versions = b.page_versions();
+  for (std::size_t page = 0; page < page_count; ++page) {
+    if (versions[page] == published[page] && !b.bound_pages().test(page)) {
+      continue;
+    }
+    const auto memory = b.page_memory(page);
+    if (memory.empty()) {
+      continue;
+    }
+    published[page] = versions[page];
+    for (std::size_t cell = 0; cell < page_cells; ++cell) {
+      auto word = std::uint64_t{0};
+      std::memcpy(&word, memory.subspan(cell * cell_size, cell_size).data(), cell_size);
+      cells[page * page_cells + cell].store(word, std::memory_order_release);
+    }
+  }
+
+  sequence.store(seq + 2, std::memory_order_release);
+}
+
+auto memory_view::snapshot() const -> memory_snapshot {
+  return snapshot(address_range{address{0x0000}, address{0xFFFF}});
+}
+
+auto memory_view::snapshot(address_range range) const -> memory_snapshot {
+  const auto first = range.from.raw / cell_size;
+  const auto last = range.till.raw / cell_size;
+  auto words = std::vector<std::uint64_t>(last - first + 1);
+  auto result = memory_snapshot{};
+  while (true) {
+    const auto before = sequence.load(std::memory_order_acquire);
+    if (before % 2 == 0) {
+      result.cpu = unpack(cpu_cell.load(std::memory_order_acquire));
+      result.cycle = cycle_cell.load(std::memory_order_acquire);
+      for (std::size_t i = 0; i < words.size(); ++i) {
+        words[i] = cells[first + i].load(std::memory_order_acquire);
+      }
+      if (sequence.load(std::memory_order_relaxed) == before) {
+        result.generation = before / 2;
+        break;
+      }
+    }
+  }
+  const auto bytes = std::as_bytes(std::span{words}).subspan(range.from.raw % cell_size, range.size());
+  result.memory.assign(bytes.begin(), bytes.end());
+  return result;
+}
+}; // namespace erelic
@@ -0,0 +1,63 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "registers.hpp"
+
+namespace erelic {
+struct memory_snapshot {
+  registers cpu;
+  std::uint64_t cycle = 0;
+  // Number of `publish` calls the snapshot reflects.
+  std::uint64_t generation = 0;
+  // Bytes of the requested range, starting at its first address.
+  std::vector<std::byte> memory{};
+};
+
+// Publication point for memory and registers between the emulation thread and observers such as a debugger UI or
+// telemetry. The emulation thread calls `publish` at an instruction boundary of its choice, which copies the pages of
+// the bus backed by a `memory_device` that changed since the previous publish according to `bus::page_versions`, plus
+// every bound page. Writes from the core, from devices and DMA through the bus and through bound pages are all seen;
+// pages of other devices are not read, to avoid their side effects, and read as zero. Any number of observer threads
+// read through `snapshot`, which is consistent, all bytes and registers coming from the same `publish`, under a
+// sequence lock over release/acquire atomics as in `statistics`. The emulation thread never blocks; observers retry
+// while a publish is in progress, so reading a small range is much less likely to retry than reading the whole space.
+class memory_view {
+public:
+  // Before the first `publish`, snapshots hold zeroed memory and power-on registers.
+  memory_view();
+
+  // Single writer, the emulation thread.
+  void publish(const registers &cpu, std::uint64_t cycle, bus &b) noexcept;
+
+  // Any thread.
+  [[nodiscard]] auto snapshot() const -> memory_snapshot;
+  [[nodiscard]] auto snapshot(address_range range) const -> memory_snapshot;
+  [[nodiscard]] auto generation() const noexcept -> std::uint64_t {
+    return sequence.load(std::memory_order_acquire) / 2;
+  }
+
+private:
+  static constexpr std::size_t cell_size = sizeof(std::uint64_t);
+  static constexpr std::size_t page_cells = page_size / cell_size;
+
+private:
+  std::atomic<std::uint64_t> sequence{0};
+  std::atomic<std::uint64_t> cpu_cell{0};
+  std::atomic<std::uint64_t> cycle_cell{0};
+  std::vector<std::atomic<std::uint64_t>> cells;
+  // `bus::page_versions` as of the last publish; all unseen at first.
+  std::array<std::uint64_t, page_count> published{};
+};
+}; // namespace erelic
@@ -0,0 +1,295 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "micro_ops.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <span>
+
+#include "instruction_tables.hpp"
+
+namespace {
+using namespace erelic;
+
+// What an instruction with a memory operand does with it.
+enum class operand_use {
+  NONE,
+  READ,
+  STOR,
+  MODI,
+};
+
+consteval auto operand_use_of(mnemonic op) -> operand_use {
+  switch (op) {
+    case mnemonic::ADC: [[fallthrough]];
+    case mnemonic::AND: [[fallthrough]];
+    case mnemonic::BIT: [[fallthrough]];
+    case mnemonic::CMP: [[fallthrough]];
+    case mnemonic::CPX: [[fallthrough]];
+    case mnemonic::CPY: [[fallthrough]];
+    case mnemonic::EOR: [[fallthrough]];
+    case mnemonic::LAS: [[fallthrough]];
+    case mnemonic::LAX: [[fallthrough]];
+    case mnemonic::LDA: [[fallthrough]];
+    case mnemonic::LDX: [[fallthrough]];
+    case mnemonic::LDY: [[fallthrough]];
+    case mnemonic::NOP: [[fallthrough]];
+    case mnemonic::ORA: [[fallthrough]];
+    case mnemonic::SBC: return operand_use::READ;
+    case mnemonic::SAX: [[fallthrough]];
+    case mnemonic::SHA: [[fallthrough]];
+    case mnemonic::SHX: [[fallthrough]];
+    case mnemonic::SHY: [[fallthrough]];
+    case mnemonic::STA: [[fallthrough]];
+    case mnemonic::STX: [[fallthrough]];
+    case mnemonic::STY: [[fallthrough]];
+    case mnemonic::STZ: [[fallthrough]];
+    case mnemonic::TAS: return operand_use::STOR;
+    case mnemonic::ASL: [[fallthrough]];
+    case mnemonic::DCP: [[fallthrough]];
+    case mnemonic::DEC: [[fallthrough]];
+    case mnemonic::INC: [[fallthrough]];
+    case mnemonic::ISC: [[fallthrough]];
+    case mnemonic::LSR: [[fallthrough]];
+    case mnemonic::RLA: [[fallthrough]];
+    case mnemonic::RMB0: [[fallthrough]];
+    case mnemonic::RMB1: [[fallthrough]];
+    case mnemonic::RMB2: [[fallthrough]];
+    case mnemonic::RMB3: [[fallthrough]];
+    case mnemonic::RMB4: [[fallthrough]];
+    case mnemonic::RMB5: [[fallthrough]];
+    case mnemonic::RMB6: [[fallthrough]];
+    case mnemonic::RMB7: [[fallthrough]];
+    case mnemonic::ROL: [[fallthrough]];
+    case mnemonic::ROR: [[fallthrough]];
+    case mnemonic::RRA: [[fallthrough]];
+    case mnemonic::SLO: [[fallthrough]];
+    case mnemonic::SMB0: [[fallthrough]];
+    case mnemonic::SMB1: [[fallthrough]];
+    case mnemonic::SMB2: [[fallthrough]];
+    case mnemonic::SMB3: [[fallthrough]];
+    case mnemonic::SMB4: [[fallthrough]];
+    case mnemonic::SMB5: [[fallthrough]];
+    case mnemonic::SMB6: [[fallthrough]];
+    case mnemonic::SMB7: [[fallthrough]];
+    case mnemonic::SRE: [[fallthrough]];
+    case mnemonic::TRB: [[fallthrough]];
+    case mnemonic::TSB: return operand_use::MODI;
+    default: return operand_use::NONE;
+  }
+}
+
+consteval void append(micro_program &program, std::initializer_list<micro_op> ops) {
+  for (const auto op : ops) {
+    program.ops.at(program.size++) = op;
+  }
+}
+
+// Cycles resolving the effective address of a memory operand. Indexed modes spend the carry cycle either always
+// (stores and read-modify-writes) or only on a page crossing (reads with a `cycles_with_penalty` penalty).
+consteval void append_addressing(micro_program &program, const instruction &info) {
+  const auto penalty = cycles_with_penalty(info, page_boundary::NEXT) > cycles_with_penalty(info, page_boundary::SAME);
+  const auto fixup = penalty ? micro_op::PAGE : micro_op::DFIX;
+  const auto carries = penalty || operand_use_of(info.op) != operand_use::READ;
+
+  switch (info.mode) {
+    case address_mode::ZPAG: append(program, {micro_op::FADL}); break;
+    case address_mode::ZPAX: append(program, {micro_op::FADL, micro_op::ZIDX}); break;
+    case address_mode::ZPAY: append(program, {micro_op::FADL, micro_op::ZIDY}); break;
+    case address_mode::ABSL: append(program, {micro_op::FADL, micro_op::FADH}); break;
+    case address_mode::ABSX: append(program, {micro_op::FADL, micro_op::FAHX}); break;
+    case address_mode::ABSY: append(program, {micro_op::FADL, micro_op::FAHY}); break;
+    case address_mode::INDX: append(program, {micro_op::FADL, micro_op::ZIDX, micro_op::ZPTL, micro_op::ZPTH}); break;
+    case address_mode::INDY: append(program, {micro_op::FADL, micro_op::ZPTL, micro_op::ZPHY}); break;
+    case address_mode::ZPIN: append(program, {micro_op::FADL, micro_op::ZPTL, micro_op::ZPTH}); break;
+    default: break;
+  }
+  const auto indexed =
+    info.mode == address_mode::ABSX || info.mode == address_mode::ABSY || info.mode == address_mode::INDY;
+  if (indexed && carries) {
+    append(program, {fixup});
+  }
+}
+
+consteval auto make_micro_program(const instruction &info, instruction_set set) -> micro_program {
+  auto program = micro_program{};
+  append(program, {micro_op::FOPC});
+  if (info.cycles == 0) {
+    append(program, {micro_op::HALT});
+    return program;
+  }
+
+  switch (info.op) {
+    case mnemonic::BRK:
+      append(program, {micro_op::FPAD, micro_op::PSHH, micro_op::PSHL, micro_op::PUSH, micro_op::VECL, micro_op::VECH});
+      return program;
+    case mnemonic::JSR:
+      append(program, {micro_op::FADL, micro_op::DSTK, micro_op::PSHH, micro_op::PSHL, micro_op::JMPH});
+      return program;
+    case mnemonic::RTS:
+      append(program, {micro_op::DUMY, micro_op::DSTK, micro_op::PLPL, micro_op::PLPH, micro_op::DINC});
+      return program;
+    case mnemonic::RTI:
+      append(program, {micro_op::DUMY, micro_op::DSTK, micro_op::PULL, micro_op::PLPL, micro_op::PLPH});
+      return program;
+    case mnemonic::PHA: [[fallthrough]];
+    case mnemonic::PHP: [[fallthrough]];
+    case mnemonic::PHX: [[fallthrough]];
+    case mnemonic::PHY: append(program, {micro_op::DUMY, micro_op::PUSH}); return program;
+    case mnemonic::PLA: [[fallthrough]];
+    case mnemonic::PLP: [[fallthrough]];
+    case mnemonic::PLX: [[fallthrough]];
+    case mnemonic::PLY: append(program, {micro_op::DUMY, micro_op::DSTK, micro_op::PULL}); return program;
+    case mnemonic::STP: [[fallthrough]];
+    case mnemonic::WAI: append(program, {micro_op::DUMY, micro_op::EXEC}); return program;
+    case mnemonic::JMP:
+      switch (info.mode) {
+        case address_mode::INDR:
+          if (set == instruction_set::CMOS) {
+            append(program, {micro_op::FADL, micro_op::FADH, micro_op::DUMY, micro_op::JPTL, micro_op::JPTH});
+          } else {
+            append(program, {micro_op::FADL, micro_op::FADH, micro_op::JPTL, micro_op::JPTW});
+          }
+          break;
+        case address_mode::INAX:
+          append(program, {micro_op::FADL, micro_op::FAHX, micro_op::DUMY, micro_op::JPTL, micro_op::JPTH});
+          break;
+        default: append(program, {micro_op::FADL, micro_op::JMPH}); break;
+      }
+      return program;
+    default: break;
+  }
+
+  switch (info.mode) {
+    case address_mode::RELA: append(program, {micro_op::FOFS, micro_op::BTKN, micro_op::BFIX}); return program;
+    case address_mode::ZPRL:
+      append(program, {micro_op::FADL, micro_op::LOAD, micro_op::DRED, micro_op::FOFS, micro_op::BTKN, micro_op::BFIX});
+      return program;
+    case address_mode::ACCU: [[fallthrough]];
+    case address_mode::IMPL:
+      if (info.cycles > 1) {
+        append(program, {micro_op::EXEC});
+      }
+      return program;
+    case address_mode::IMME: append(program, {micro_op::FIMM}); return program;
+    default: break;
+  }
+
+  append_addressing(program, info);
+  switch (operand_use_of(info.op)) {
+    case operand_use::READ:
+      // Undocumented CMOS NOPs take longer than their addressing mode.
+      while (program.size + 1 < info.cycles) {
+        append(program, {micro_op::DUMY});
+      }
+      append(program, {micro_op::READ});
+      break;
+    case operand_use::STOR: append(program, {micro_op::WRIT}); break;
+    case operand_use::MODI:
+      append(program, {micro_op::LOAD, set == instruction_set::CMOS ? micro_op::DRED : micro_op::DWRT, micro_op::WRIT});
+      break;
+    case operand_use::NONE: break;
+  }
+  return program;
+}
+
+consteval auto make_micro_program_table(const instruction_table &table, instruction_set set) {
+  auto programs = micro_program_table{};
+  for (auto index = 0U; index < std::size(table); ++index) {
+    programs[index] = make_micro_program(table[index], set);
+  }
+  return programs;
+}
+
+consteval auto matches_cycles(const micro_program_table &programs, const instruction_table &table) -> bool {
+  for (auto index = 0U; index < std::size(table); ++index) {
+    const auto &info = table[index];
+    const auto ops = std::span{programs[index].ops}.first(programs[index].size);
+    if (info.cycles == 0) {
+      if (ops.back() != micro_op::HALT) {
+        return false;
+      }
+      continue;
+    }
+    const auto page = static_cast<std::size_t>(std::ranges::count(ops, micro_op::PAGE));
+    const auto taken = static_cast<std::size_t>(std::ranges::count(ops, micro_op::BTKN));
+    const auto carry = static_cast<std::size_t>(std::ranges::count(ops, micro_op::BFIX));
+    if (ops.size() - page - carry != cycles_with_penalty(info, page_boundary::SAME) ||
+        ops.size() != cycles_with_penalty(info, page_boundary::NEXT)) {
+      return false;
+    }
+    if (taken != 0 && info.op != mnemonic::BRA && ops.size() - taken - carry != info.cycles) {
+      return false;
+    }
+  }
+  return true;
+}
+
+constexpr auto stnd_micro_programs = make_micro_program_table(stnd_lookup_table, instruction_set::STND);
+constexpr auto nmos_micro_programs = make_micro_program_table(nmos_lookup_table, instruction_set::NMOS);
+constexpr auto cmos_micro_programs = make_micro_program_table(cmos_lookup_table, instruction_set::CMOS);
+
+static_assert(matches_cycles(stnd_micro_programs, stnd_lookup_table));
+static_assert(matches_cycles(nmos_micro_programs, nmos_lookup_table));
+static_assert(matches_cycles(cmos_micro_programs, cmos_lookup_table));
+}; // namespace
+
+namespace erelic {
+auto operator<<(std::ostream &os, const micro_op &op) -> std::ostream & {
+  switch (op) {
+    case micro_op::FOPC: os << "FOPC"; break;
+    case micro_op::FIMM: os << "FIMM"; break;
+    case micro_op::FPAD: os << "FPAD"; break;
+    case micro_op::FOFS: os << "FOFS"; break;
+    case micro_op::FADL: os << "FADL"; break;
+    case micro_op::FADH: os << "FADH"; break;
+    case micro_op::FAHX: os << "FAHX"; break;
+    case micro_op::FAHY: os << "FAHY"; break;
+    case micro_op::JMPH: os << "JMPH"; break;
+    case micro_op::ZIDX: os << "ZIDX"; break;
+    case micro_op::ZIDY: os << "ZIDY"; break;
+    case micro_op::ZPTL: os << "ZPTL"; break;
+    case micro_op::ZPTH: os << "ZPTH"; break;
+    case micro_op::ZPHY: os << "ZPHY"; break;
+    case micro_op::JPTL: os << "JPTL"; break;
+    case micro_op::JPTH: os << "JPTH"; break;
+    case micro_op::JPTW: os << "JPTW"; break;
+    case micro_op::PAGE: os << "PAGE"; break;
+    case micro_op::DFIX: os << "DFIX"; break;
+    case micro_op::READ: os << "READ"; break;
+    case micro_op::LOAD: os << "LOAD"; break;
+    case micro_op::DRED: os << "DRED"; break;
+    case micro_op::DWRT: os << "DWRT"; break;
+    case micro_op::WRIT: os << "WRIT"; break;
+    case micro_op::EXEC: os << "EXEC"; break;
+    case micro_op::DUMY: os << "DUMY"; break;
+    case micro_op::DSTK: os << "DSTK"; break;
+    case micro_op::PUSH: os << "PUSH"; break;
+    case micro_op::PULL: os << "PULL"; break;
+    case micro_op::PSHH: os << "PSHH"; break;
+    case micro_op::PSHL: os << "PSHL"; break;
+    case micro_op::PLPL: os << "PLPL"; break;
+    case micro_op::PLPH: os << "PLPH"; break;
+    case micro_op::DINC: os << "DINC"; break;
+    case micro_op::VECL: os << "VECL"; break;
+    case micro_op::VECH: os << "VECH"; break;
+    case micro_op::BTKN: os << "BTKN"; break;
+    case micro_op::BFIX: os << "BFIX"; break;
+    case micro_op::HALT: os << "HALT"; break;
+  }
+  return os;
+}
+
+auto micro_program_table_for(instruction_set set) noexcept -> const micro_program_table & {
+  switch (set) {
+    case instruction_set::STND: return stnd_micro_programs;
+    case instruction_set::NMOS: return nmos_micro_programs;
+    case instruction_set::CMOS: return cmos_micro_programs;
+  }
+  return stnd_micro_programs;
+}
+}; // namespace erelic
@@ -0,0 +1,320 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "core_hooks.hpp"
+#include "instruction.hpp"
+#include "registers.hpp"
+
+namespace erelic {
+// One cycle of an instruction, i.e. exactly one bus access. The effective address is the operand address resolved by
+// the addressing mode. Dummy accesses are the ones the chip performs without using the result; they are replayed for
+// devices with access side effects, at the addresses the NMOS 6502 uses.
+enum class micro_op {
+  FOPC, // fetch opcode and decode
+  FIMM, // fetch immediate operand and execute
+  FPAD, // fetch and discard the padding byte after BRK
+  FOFS, // fetch branch offset
+  FADL, // fetch effective address low byte, the whole address in zero page modes
+  FADH, // fetch effective address high byte
+  FAHX, // fetch effective address high byte, index by X
+  FAHY, // fetch effective address high byte, index by Y
+  JMPH, // fetch target high byte and jump
+  ZIDX, // dummy read of the zero page address, then index it by X within the zero page
+  ZIDY, // dummy read of the zero page address, then index it by Y within the zero page
+  ZPTL, // read pointer low byte from the zero page
+  ZPTH, // read pointer high byte from the zero page
+  ZPHY, // read pointer high byte from the zero page, index by Y
+  JPTL, // read jump vector low byte
+  JPTH, // read jump vector high byte and jump
+  JPTW, // read jump vector high byte without carrying into the page (NMOS bug) and jump
+  PAGE, // dummy read of the uncarried effective address; only when indexing crossed a page
+  DFIX, // dummy read of the uncarried effective address
+  READ, // read operand and execute
+  LOAD, // read operand
+  DRED, // dummy read of the effective address
+  DWRT, // dummy write of the unmodified operand
+  WRIT, // execute and write the result
+  EXEC, // dummy read at PC and execute
+  DUMY, // dummy read at PC
+  DSTK, // dummy read of the stack
+  PUSH, // execute and push the result
+  PULL, // pull and execute
+  PSHH, // push PC high byte
+  PSHL, // push PC low byte
+  PLPL, // pull PC low byte
+  PLPH, // pull PC high byte
+  DINC, // dummy read at PC, then increment PC
+  VECL, // read BRK vector low byte
+  VECH, // read BRK vector high byte and jump
+  BTKN, // dummy read at PC; only when the branch is taken
+  BFIX, // dummy read of the uncarried target; only when the taken branch crossed a page
+  HALT, // dummy read of $FFFF, repeated forever (JAM)
+};
+
+auto operator<<(std::ostream &os, const micro_op &op) -> std::ostream &;
+
+constexpr auto max_micro_ops = std::size_t{8};
+
+// Cycles of one opcode, starting with its `FOPC`. Without the conditional `PAGE`, `BTKN` and `BFIX` cycles the count is
+// `instruction::cycles`, with them it is `cycles_with_penalty`; a `JAM` never completes and has 0 cycles.
+struct micro_program {
+  std::array<micro_op, max_micro_ops> ops{};
+  std::size_t size = 0;
+
+  auto operator==(const micro_program &o) const noexcept -> bool = default;
+};
+
+using micro_program_table = std::array<micro_program, 256>;
+
+// Programs of `set`, indexed by opcode like `instruction_table_for(set)`.
+[[nodiscard]] auto micro_program_table_for(instruction_set set) noexcept -> const micro_program_table &;
+
+// Instruction semantics for `micro_engine`. `execute` is called on the cycle an instruction consumes its operand or
+// produces its result, with the byte read on that cycle and the effective address, and returns the byte to write or
+// push. `taken` decides a branch once its offset is fetched; `value` is the zero page byte for BBR/BBS. BRA is taken.
+template <typename T>
+concept micro_core = requires(T core, const instruction &info, std::byte value, address effective) {
+  { core.execute(info, value, effective) } noexcept -> std::same_as<std::byte>;
+  { core.taken(info, value) } noexcept -> std::same_as<bool>;
+};
+
+// Runs instructions one bus access per cycle, so accesses interleave with the rest of the machine in the order the chip
+// issues them. The engine owns addressing, PC, S and the stack; X and Y are read from `regs` on the cycle they index.
+// `Hooks` instruments the engine, see `core_hooks`; BRK is reported as an interrupt through $FFFE.
+template <io_bus Bus, micro_core Core, core_hooks Hooks = no_hooks>
+class micro_engine {
+public:
+  micro_engine(Bus &bus, Core &core, registers &regs, instruction_set set, Hooks hooks = {}) noexcept
+      : bus{&bus}, core{&core}, regs{&regs}, instructions{&instruction_table_for(set)},
+        programs{&micro_program_table_for(set)}, info{&(*instructions)[0xEA]}, hooks{std::move(hooks)} {}
+
+  // Runs one cycle; true if it completed an instruction.
+  auto tick() noexcept -> bool {
+    const auto op = program->ops[index];
+    if (op == micro_op::HALT) {
+      (void)read(0xFFFF);
+      return false;
+    }
+    run(op);
+    ++index;
+    skip_conditional();
+    if (index < program->size) {
+      return false;
+    }
+    program = &fetch;
+    index = 0;
+    hooks.on_retire(address{start}, *info, *regs);
+    return true;
+  }
+
+  // Runs to the next instruction boundary and returns the cycles taken, or stops at the first cycle of a jam.
+  auto step() noexcept -> std::size_t {
+    auto cycles = std::size_t{1};
+    while (!tick() && !jammed()) {
+      ++cycles;
+    }
+    return cycles;
+  }
+
+  [[nodiscard]] auto jammed() const noexcept -> bool { return program->ops[index] == micro_op::HALT; }
+
+  // Instruction in flight, or the one last completed at an instruction boundary.
+  [[nodiscard]] auto current() const noexcept -> const instruction & { return *info; }
+
+  [[nodiscard]] auto observer() noexcept -> Hooks & { return hooks; }
+
+private:
+  static constexpr auto fetch = micro_program{.ops = {micro_op::FOPC}, .size = 1};
+
+  [[nodiscard]] auto read(address_raw a) noexcept -> std::byte {
+    const auto v = bus->read(address{a});
+    hooks.on_read(address{a}, v);
+    return v;
+  }
+  void write(address_raw a, std::byte v) noexcept {
+    (void)bus->write(address{a}, v);
+    hooks.on_write(address{a}, v);
+  }
+  [[nodiscard]] auto pc() const noexcept -> address_raw { return regs->pc.raw; }
+  void jump(address_raw to) noexcept { regs->pc = address{to}; }
+  auto read_pc() noexcept -> std::byte {
+    const auto v = read(pc());
+    jump(wrap(pc() + 1U));
+    return v;
+  }
+  [[nodiscard]] auto stack() const noexcept -> address_raw {
+    return wrap(0x0100U | std::to_integer<unsigned>(regs->s));
+  }
+  void push(std::byte v) noexcept {
+    write(stack(), v);
+    regs->s = static_cast<std::byte>(std::to_integer<std::uint8_t>(regs->s) - 1);
+  }
+  auto pull() noexcept -> std::byte {
+    regs->s = static_cast<std::byte>(std::to_integer<std::uint8_t>(regs->s) + 1);
+    return read(stack());
+  }
+  static constexpr auto wrap(unsigned v) noexcept -> address_raw { return static_cast<address_raw>(v); }
+  static constexpr auto low(std::byte v) noexcept -> address_raw { return std::to_integer<address_raw>(v); }
+  static constexpr auto high(std::byte v) noexcept -> address_raw { return wrap(std::to_integer<unsigned>(v) << 8U); }
+  [[nodiscard]] auto uncarried() const noexcept -> address_raw {
+    return wrap((base & 0xFF00U) | (effective & 0x00FFU));
+  }
+  void index_by(address_raw from, std::byte by) noexcept {
+    base = from;
+    effective = wrap(from + std::to_integer<unsigned>(by));
+    crossed = ((base ^ effective) & 0xFF00U) != 0;
+  }
+
+  // Skips conditional cycles that do not happen this time.
+  void skip_conditional() noexcept {
+    for (; index < program->size; ++index) {
+      switch (program->ops[index]) {
+        case micro_op::PAGE:
+          if (crossed) {
+            return;
+          }
+          break;
+        case micro_op::BTKN:
+          taken = core->taken(*info, value);
+          if (taken) {
+            return;
+          }
+          break;
+        case micro_op::BFIX:
+          if (taken && crossed) {
+            return;
+          }
+          break;
+        default: return;
+      }
+    }
+  }
+
+  void run(micro_op op) noexcept {
+    switch (op) {
+      case micro_op::FOPC: {
+        start = pc();
+        const auto byte = read_pc();
+        hooks.on_fetch(address{start}, byte);
+        const auto opcode = std::to_integer<std::size_t>(byte);
+        program = &(*programs)[opcode];
+        info = &(*instructions)[opcode];
+        index = 0;
+        crossed = false;
+        taken = false;
+        break;
+      }
+      case micro_op::FIMM:
+        effective = pc();
+        value = read_pc();
+        (void)core->execute(*info, value, address{effective});
+        break;
+      case micro_op::FPAD: (void)read_pc(); break;
+      case micro_op::FOFS: offset = read_pc(); break;
+      case micro_op::FADL: effective = low(read_pc()); break;
+      case micro_op::FADH: effective = wrap(effective | high(read_pc())); break;
+      case micro_op::FAHX: index_by(wrap(effective | high(read_pc())), regs->x); break;
+      case micro_op::FAHY: index_by(wrap(effective | high(read_pc())), regs->y); break;
+      case micro_op::JMPH: jump(wrap(effective | high(read_pc()))); break;
+      case micro_op::ZIDX:
+        (void)read(effective);
+        effective = wrap((effective + std::to_integer<unsigned>(regs->x)) & 0x00FFU);
+        break;
+      case micro_op::ZIDY:
+        (void)read(effective);
+        effective = wrap((effective + std::to_integer<unsigned>(regs->y)) & 0x00FFU);
+        break;
+      case micro_op::ZPTL:
+        pointer = effective;
+        effective = low(read(pointer));
+        break;
+      case micro_op::ZPTH: effective = wrap(effective | high(read(wrap((pointer + 1U) & 0x00FFU)))); break;
+      case micro_op::ZPHY: index_by(wrap(effective | high(read(wrap((pointer + 1U) & 0x00FFU)))), regs->y); break;
+      case micro_op::JPTL:
+        pointer = effective;
+        value = read(pointer);
+        break;
+      case micro_op::JPTH: jump(wrap(low(value) | high(read(wrap(pointer + 1U))))); break;
+      case micro_op::JPTW:
+        jump(wrap(low(value) | high(read(wrap((pointer & 0xFF00U) | ((pointer + 1U) & 0x00FFU))))));
+        break;
+      case micro_op::PAGE: [[fallthrough]];
+      case micro_op::DFIX: (void)read(uncarried()); break;
+      case micro_op::READ:
+        value = read(effective);
+        (void)core->execute(*info, value, address{effective});
+        break;
+      case micro_op::LOAD: value = read(effective); break;
+      case micro_op::DRED: (void)read(effective); break;
+      case micro_op::DWRT: write(effective, value); break;
+      case micro_op::WRIT: write(effective, core->execute(*info, value, address{effective})); break;
+      case micro_op::EXEC:
+        value = read(pc());
+        (void)core->execute(*info, value, regs->pc);
+        break;
+      case micro_op::DUMY: (void)read(pc()); break;
+      case micro_op::DSTK: (void)read(stack()); break;
+      case micro_op::PUSH: push(core->execute(*info, value, address{stack()})); break;
+      case micro_op::PULL:
+        value = pull();
+        (void)core->execute(*info, value, address{stack()});
+        break;
+      case micro_op::PSHH: push(static_cast<std::byte>(pc() >> 8U)); break;
+      case micro_op::PSHL: push(static_cast<std::byte>(pc() & 0x00FFU)); break;
+      case micro_op::PLPL: effective = low(pull()); break;
+      case micro_op::PLPH: jump(wrap(effective | high(pull()))); break;
+      case micro_op::DINC: (void)read_pc(); break;
+      case micro_op::VECL:
+        hooks.on_interrupt(address{0xFFFE});
+        effective = low(read(0xFFFE));
+        break;
+      case micro_op::VECH: jump(wrap(effective | high(read(0xFFFF)))); break;
+      case micro_op::BTKN:
+        (void)read(pc());
+        base = pc();
+        effective = wrap(pc() + static_cast<unsigned>(std::to_integer<std::int8_t>(offset)));
+        crossed = ((base ^ effective) & 0xFF00U) != 0;
+        if (!crossed) {
+          jump(effective);
+        }
+        break;
+      case micro_op::BFIX:
+        (void)read(uncarried());
+        jump(effective);
+        break;
+      case micro_op::HALT: (void)read(0xFFFF); break;
+    }
+  }
+
+private:
+  Bus *bus;
+  Core *core;
+  registers *regs;
+  const instruction_table *instructions;
+  const micro_program_table *programs;
+  const micro_program *program = &fetch;
+  const instruction *info;
+  [[no_unique_address]] Hooks hooks;
+  std::size_t index = 0;
+  address_raw start = 0;
+  address_raw effective = 0;
+  address_raw base = 0;
+  address_raw pointer = 0;
+  std::byte value{0x00};
+  std::byte offset{0x00};
+  bool crossed = false;
+  bool taken = false;
+};
+}; // namespace erelic
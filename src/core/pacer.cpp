@@ -0,0 +1,40 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "pacer.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <ctime>
+#include <thread>
+
+namespace erelic {
+// `steady_clock` is `CLOCK_MONOTONIC` on Linux, so its time points can be handed to `clock_nanosleep` directly.
+void host_clock::sleep_until(pacing_time until) noexcept {
+#if defined(__linux__)
+  const auto since_epoch = until.time_since_epoch();
+  const auto secs = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+  const auto ts = timespec{.tv_sec = static_cast<std::time_t>(secs.count()),
+                           .tv_nsec = static_cast<long>((since_epoch - secs).count())};
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+  }
+#else
+  std::this_thread::sleep_until(until);
+#endif
+}
+
+void host_clock::spin() noexcept { std::this_thread::yield(); }
+
+auto host_clock::cpu_time() noexcept -> std::chrono::nanoseconds {
+#if defined(__linux__)
+  auto ts = timespec{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+#else
+  // Process time where per-thread time is not available.
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double>{static_cast<double>(std::clock()) / CLOCKS_PER_SEC});
+#endif
+}
+}; // namespace erelic
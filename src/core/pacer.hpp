@@ -0,0 +1,160 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace erelic {
+struct pacing_stats {
+  std::uint64_t slices = 0;
+  // Slices whose emulation alone took longer than their real-time budget; no sleep happened after them.
+  std::uint64_t overruns = 0;
+  // Times the schedule was re-anchored because emulation fell more than `max_lag` behind.
+  std::uint64_t resyncs = 0;
+  // Wake-up error against the slice deadline, over slices that slept.
+  std::chrono::nanoseconds mean_jitter{0};
+  std::chrono::nanoseconds max_jitter{0};
+  // Host CPU time of the pacing thread (emulation plus spinning) per wall time, 1.0 being one full core.
+  double cpu_usage = 0.0;
+};
+
+using pacing_time = std::chrono::steady_clock::time_point;
+
+// Time source of a pacer: the current time, an absolute sleep, one iteration of the spin before a deadline and the CPU
+// time used by the calling thread.
+template <typename T>
+concept pacing_clock = requires(T c, pacing_time until) {
+  { c.now() } -> std::same_as<pacing_time>;
+  { c.sleep_until(until) };
+  { c.spin() };
+  { c.cpu_time() } -> std::same_as<std::chrono::nanoseconds>;
+};
+
+// The host monotonic clock. Sleeps with `clock_nanosleep` on Linux.
+struct host_clock {
+  [[nodiscard]] static auto now() noexcept -> pacing_time { return std::chrono::steady_clock::now(); }
+  static void sleep_until(pacing_time until) noexcept;
+  static void spin() noexcept;
+  [[nodiscard]] static auto cpu_time() noexcept -> std::chrono::nanoseconds;
+};
+
+static_assert(pacing_clock<host_clock>);
+
+// Runs the core in cycle slices at a real clock rate. Deadlines are absolute, derived from the total number of cycles
+// run since the anchor, so rounding and oversleeping never accumulate into drift. Waiting sleeps until `spin_window`
+// before the deadline and spins only for that remainder, which keeps an idle paced instance near zero CPU.
+template <pacing_clock Clock = host_clock>
+class pacer {
+public:
+  // Throws `std::invalid_argument` if `clock_hz` or `slice_cycles` is zero.
+  pacer(std::uint64_t clock_hz, std::uint64_t slice_cycles,
+        std::chrono::nanoseconds spin_window = std::chrono::microseconds{100},
+        std::chrono::nanoseconds max_lag = std::chrono::milliseconds{50}, Clock time = {})
+      : clock_hz{clock_hz}, slice_cycles{slice_cycles}, spin_window{spin_window}, max_lag{max_lag},
+        time{std::move(time)} {
+    if (clock_hz == 0 || slice_cycles == 0) {
+      throw std::invalid_argument("pacer: clock rate and slice length must be non-zero");
+    }
+  }
+
+  // Runs one slice through `run(cycles)`, which returns the cycles actually executed (instructions may overshoot the
+  // slice), then waits until the real time those cycles are due.
+  template <typename F>
+    requires std::invocable<F &, std::uint64_t> &&
+             std::convertible_to<std::invoke_result_t<F &, std::uint64_t>, std::uint64_t>
+  void step(F &&run) {
+    if (!started) {
+      restart();
+    }
+    cycles += static_cast<std::uint64_t>(run(slice_cycles));
+    wait();
+  }
+
+  // Re-anchors the schedule at the current time, e.g. after the emulator was paused.
+  void restart() {
+    started = true;
+    anchor = time.now();
+    cycles = 0;
+    if (stats.slices == 0) {
+      wall_start = anchor;
+      cpu_start = time.cpu_time();
+    }
+  }
+
+  // Updated by `step`; read from the pacing thread or copy under external synchronization.
+  [[nodiscard]] auto statistics() const noexcept -> const pacing_stats & { return stats; }
+
+private:
+  void wait() {
+    ++stats.slices;
+    const auto due = deadline();
+    const auto now = time.now();
+
+    if (now >= due) {
+      ++stats.overruns;
+      if (now - due > max_lag) {
+        ++stats.resyncs;
+        anchor = now;
+        cycles = 0;
+      }
+      update_cpu_usage(now);
+      return;
+    }
+
+    if (due - now > spin_window) {
+      time.sleep_until(due - spin_window);
+    }
+    auto woke = time.now();
+    while (woke < due) {
+      time.spin();
+      woke = time.now();
+    }
+
+    const auto jitter = std::chrono::duration_cast<std::chrono::nanoseconds>(woke - due);
+    ++slept;
+    total_jitter += jitter;
+    stats.max_jitter = std::max(stats.max_jitter, jitter);
+    stats.mean_jitter = total_jitter / slept;
+    update_cpu_usage(woke);
+  }
+
+  void update_cpu_usage(pacing_time now) noexcept {
+    const auto wall = std::chrono::duration<double>(now - wall_start).count();
+    if (wall > 0.0) {
+      stats.cpu_usage = std::chrono::duration<double>(time.cpu_time() - cpu_start).count() / wall;
+    }
+  }
+
+  [[nodiscard]] auto deadline() const noexcept -> pacing_time {
+    // Split to keep `cycles * 1e9` from overflowing on long runs.
+    const auto secs = cycles / clock_hz;
+    const auto rest = cycles % clock_hz;
+    return anchor + std::chrono::seconds{secs} + std::chrono::nanoseconds{rest * 1'000'000'000 / clock_hz};
+  }
+
+private:
+  std::uint64_t clock_hz;
+  std::uint64_t slice_cycles;
+  std::chrono::nanoseconds spin_window;
+  std::chrono::nanoseconds max_lag;
+  [[no_unique_address]] Clock time;
+
+  bool started = false;
+  pacing_time anchor;
+  std::uint64_t cycles = 0;
+
+  pacing_stats stats;
+  std::chrono::nanoseconds total_jitter{0};
+  std::uint64_t slept = 0;
+  pacing_time wall_start;
+  std::chrono::nanoseconds cpu_start{0};
+};
+}; // namespace erelic
@@ -0,0 +1,18 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "quantum_scheduler.hpp"
+
+#include <ostream>
+
+namespace erelic {
+auto operator<<(std::ostream &os, const execution_mode &m) -> std::ostream & {
+  switch (m) {
+    case execution_mode::SERIAL: os << "SERIAL"; break;
+    case execution_mode::PARALLEL: os << "PARALLEL"; break;
+    case execution_mode::LOCKSTEP: os << "LOCKSTEP"; break;
+  }
+  return os;
+}
+}; // namespace erelic
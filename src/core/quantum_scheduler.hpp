@@ -0,0 +1,260 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <barrier>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "snapshot.hpp"
+
+namespace erelic {
+// CPU that can be driven to a cycle boundary; it may overshoot by the tail of its last instruction. Its state must
+// cover everything it changes besides the shared devices, so that a quantum can be run again.
+template <typename T>
+concept quantum_cpu = snapshottable<T> && requires(T cpu, std::uint64_t cycle) {
+  { cpu.run_until(cycle) } -> std::same_as<std::uint64_t>;
+};
+
+// Device shared by the CPUs of a `quantum_scheduler`, such as `shared_memory`. `first_conflict` tells where the
+// finished quantum must end to give the one-cycle result, `commit` applies its writes and returns whether there were
+// any, `discard` drops them.
+template <typename T>
+concept quantum_shared = requires(T shared) {
+  { shared.first_conflict() } -> std::same_as<std::optional<std::uint64_t>>;
+  { shared.commit() } -> std::same_as<bool>;
+  { shared.discard() } -> std::same_as<void>;
+};
+
+enum class execution_mode {
+  SERIAL,   // every quantum runs the CPUs one after another on the calling thread
+  PARALLEL, // every CPU runs on its own host thread, meeting at a barrier after each quantum
+  LOCKSTEP, // reference: one-cycle quanta on the calling thread, as an instruction-interleaving emulator would run
+};
+
+auto operator<<(std::ostream &os, const execution_mode &m) -> std::ostream &;
+
+// Runs several CPUs in bounded cycle quanta. After each quantum all CPUs stop at a barrier, where the shared devices
+// commit the writes of that quantum. `SERIAL` and `PARALLEL` produce exactly the results of `LOCKSTEP`: the CPUs are
+// snapshotted at every barrier, and a quantum in which a CPU read what another one wrote earlier in it is discarded
+// and run again from the snapshots, ending right after that write. A quantum with cross-CPU traffic halves the next
+// one (down to `min_quantum`), a quiet one doubles it (up to `max_quantum`), which keeps reruns rare; the quantum
+// sizes only decide the speed, never the result.
+//
+// `PARALLEL` starts one host thread per CPU at its first use; they are kept parked at the barrier between calls and
+// joined by the destructor.
+template <quantum_cpu Cpu>
+class quantum_scheduler {
+public:
+  // Each CPU state takes at most `state_capacity` bytes. Throws `std::invalid_argument` if there are no CPUs or the
+  // quantum bounds are empty.
+  quantum_scheduler(std::vector<Cpu *> cpus, std::uint64_t min_quantum, std::uint64_t max_quantum,
+                    std::size_t state_capacity)
+      : cpus{std::move(cpus)}, min_quantum{min_quantum}, max_quantum{max_quantum}, quantum{max_quantum} {
+    if (this->cpus.empty() || min_quantum == 0 || min_quantum > max_quantum) {
+      throw std::invalid_argument("quantum_scheduler: need CPUs and 0 < min_quantum <= max_quantum");
+    }
+    snapshots.reserve(this->cpus.size());
+    for (std::size_t i = 0; i < this->cpus.size(); ++i) {
+      snapshots.emplace_back(state_capacity);
+    }
+  }
+
+  // The worker threads refer to the scheduler.
+  quantum_scheduler(const quantum_scheduler &) = delete;
+  quantum_scheduler(quantum_scheduler &&) = delete;
+  auto operator=(const quantum_scheduler &) -> quantum_scheduler & = delete;
+  auto operator=(quantum_scheduler &&) -> quantum_scheduler & = delete;
+
+  ~quantum_scheduler() {
+    if (pool) {
+      stop_requested = true;
+      pool->sync.arrive_and_wait();
+    }
+  }
+
+  // The device must outlive the scheduler.
+  template <quantum_shared Shared>
+  void attach(Shared &shared) {
+    devices.push_back({[&shared] { return shared.first_conflict(); }, [&shared] { return shared.commit(); },
+                       [&shared] { shared.discard(); }});
+  }
+
+  void run_until(std::uint64_t target, execution_mode mode) {
+    if (now >= target) {
+      return;
+    }
+    switch (mode) {
+      case execution_mode::SERIAL: run_serial(target); break;
+      case execution_mode::PARALLEL: run_parallel(target); break;
+      case execution_mode::LOCKSTEP: run_lockstep(target); break;
+    }
+  }
+
+  // Cycle of the last barrier.
+  [[nodiscard]] auto cycles() const noexcept -> std::uint64_t { return now; }
+  [[nodiscard]] auto current_quantum() const noexcept -> std::uint64_t { return quantum; }
+  [[nodiscard]] auto quanta() const noexcept -> std::uint64_t { return barriers; }
+  // Quanta run again because of a conflict.
+  [[nodiscard]] auto reruns() const noexcept -> std::uint64_t { return repeated; }
+
+private:
+  struct shared_device {
+    std::function<std::optional<std::uint64_t>()> first_conflict;
+    std::function<bool()> commit;
+    std::function<void()> discard;
+  };
+
+  // Completion step of the worker barrier: starts a run or stops the workers if no run is in progress, else ends or
+  // repeats the quantum. Workers only read the state it writes, so one still leaving the previous barrier never sees a
+  // request of the calling thread early.
+  struct barrier_step {
+    quantum_scheduler *self;
+    void operator()() const noexcept {
+      if (!self->running) {
+        self->stopping = self->stop_requested;
+        self->running = !self->stop_requested;
+        if (self->running) {
+          self->capture();
+        }
+        return;
+      }
+      if (self->synchronize(self->parallel_target)) {
+        self->running = self->now < self->parallel_target;
+      }
+    }
+  };
+
+  // The workers and the calling thread meet at `sync`, which completes with `barrier_step`.
+  struct worker_pool {
+    worker_pool(std::ptrdiff_t participants, quantum_scheduler *self) : sync{participants, barrier_step{self}} {}
+
+    std::barrier<barrier_step> sync;
+    std::vector<std::jthread> threads{};
+  };
+
+  void run_serial(std::uint64_t target) {
+    end = std::min(target, now + quantum);
+    capture();
+    while (now < target) {
+      for (auto *cpu : cpus) {
+        cpu->run_until(end);
+      }
+      (void)synchronize(target);
+    }
+  }
+
+  void run_parallel(std::uint64_t target) {
+    if (!pool) {
+      start_workers();
+    }
+    parallel_target = target;
+    end = std::min(target, now + quantum);
+    pool->sync.arrive_and_wait();
+    while (running) {
+      pool->sync.arrive_and_wait();
+    }
+  }
+
+  void run_lockstep(std::uint64_t target) {
+    while (now < target) {
+      end = now + 1;
+      for (auto *cpu : cpus) {
+        cpu->run_until(end);
+      }
+      now = end;
+      ++barriers;
+      for (const auto &device : devices) {
+        (void)device.commit();
+      }
+    }
+  }
+
+  void start_workers() {
+    pool = std::make_unique<worker_pool>(static_cast<std::ptrdiff_t>(cpus.size() + 1), this);
+    pool->threads.reserve(cpus.size());
+    for (auto *cpu : cpus) {
+      pool->threads.emplace_back([this, cpu] {
+        while (true) {
+          pool->sync.arrive_and_wait();
+          if (stopping) {
+            return;
+          }
+          if (running) {
+            cpu->run_until(end);
+          }
+        }
+      });
+    }
+  }
+
+  void capture() {
+    for (std::size_t i = 0; i < cpus.size(); ++i) {
+      snapshots[i].capture(*cpus[i]);
+    }
+  }
+
+  // Ends the quantum and returns true, or rewinds the CPUs to run it again up to the first conflict and returns false.
+  auto synchronize(std::uint64_t target) -> bool {
+    auto conflict = std::optional<std::uint64_t>{};
+    for (const auto &device : devices) {
+      if (const auto c = device.first_conflict()) {
+        conflict = std::min(conflict.value_or(*c), *c);
+      }
+    }
+    if (conflict) {
+      for (const auto &device : devices) {
+        device.discard();
+      }
+      for (std::size_t i = 0; i < cpus.size(); ++i) {
+        snapshots[i].restore(*cpus[i]);
+      }
+      end = *conflict;
+      ++repeated;
+      return false;
+    }
+    now = end;
+    ++barriers;
+    auto traffic = false;
+    for (const auto &device : devices) {
+      traffic = device.commit() || traffic;
+    }
+    quantum = traffic ? std::max(min_quantum, quantum / 2) : std::min(max_quantum, quantum * 2);
+    end = std::min(target, now + quantum);
+    capture();
+    return true;
+  }
+
+private:
+  std::vector<Cpu *> cpus;
+  std::vector<state_snapshot> snapshots;
+  std::vector<shared_device> devices;
+  std::uint64_t min_quantum;
+  std::uint64_t max_quantum;
+  std::uint64_t quantum;
+  std::uint64_t now = 0;
+  std::uint64_t end = 0;
+  std::uint64_t barriers = 0;
+  std::uint64_t repeated = 0;
+
+  // Written by the calling thread between runs, read in `barrier_step`.
+  std::uint64_t parallel_target = 0;
+  bool stop_requested = false;
+  // Written in `barrier_step` only.
+  bool running = false;
+  bool stopping = false;
+  std::unique_ptr<worker_pool> pool;
+};
+}; // namespace erelic
@@ -0,0 +1,18 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "register_map.hpp"
+
+#include <ostream>
+
+namespace erelic {
+auto operator<<(std::ostream &os, const register_effect &e) -> std::ostream & {
+  switch (e) {
+    case register_effect::NONE: os << "NONE"; break;
+    case register_effect::VOLA: os << "VOLA"; break;
+    case register_effect::RDSE: os << "RDSE"; break;
+  }
+  return os;
+}
+}; // namespace erelic
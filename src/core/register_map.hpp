@@ -0,0 +1,174 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+
+namespace erelic {
+// What reading a register does besides returning its value.
+enum class register_effect {
+  NONE, // value only changes through writes: reads may be cached and polled freely
+  VOLA, // value changes on its own (counters, input lines), but reading it has no side effect
+  RDSE, // reading has a side effect, e.g. acknowledges an interrupt or pops a FIFO
+};
+
+auto operator<<(std::ostream &os, const register_effect &e) -> std::ostream &;
+
+// Register at `Offset` within the device. `Read` and `Write` are each `nullptr` (write-only or read-only register), a
+// pointer to a `std::byte` data member (plain storage), or a pointer to a member function: `std::byte()` for reads
+// and `void(std::byte)` or `write_status(std::byte)` for writes.
+template <std::size_t Offset, auto Read, auto Write = nullptr, register_effect Effect = register_effect::NONE>
+struct reg {
+  static constexpr auto offset = Offset;
+  static constexpr auto read = Read;
+  static constexpr auto write = Write;
+  static constexpr auto effect = Effect;
+};
+
+template <typename T>
+concept register_spec = std::same_as<T, reg<T::offset, T::read, T::write, T::effect>>;
+
+template <register_spec... Registers>
+consteval auto distinct_offsets() -> bool {
+  const auto offsets = std::array<std::size_t, sizeof...(Registers)>{Registers::offset...};
+  for (std::size_t i = 0; i < offsets.size(); ++i) {
+    for (std::size_t j = i + 1; j < offsets.size(); ++j) {
+      if (offsets[i] == offsets[j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// `io_device` generated from a register list over the peripheral state `Impl`. Dispatch indexes constexpr jump tables
+// by the relative address; offsets without a register read as `unmapped_read` and fail writes, read-only registers
+// ignore writes. Register effects are exposed for caching and idle-loop detection, see `pollable_device`.
+template <typename Impl, register_spec... Registers>
+  requires(sizeof...(Registers) > 0 && distinct_offsets<Registers...>())
+class register_device {
+public:
+  static constexpr std::size_t register_span = std::max({Registers::offset...}) + 1;
+
+  constexpr register_device() = default;
+  constexpr explicit register_device(Impl impl) : impl{std::move(impl)} {}
+
+  [[nodiscard]] constexpr auto read(address /*unused*/, address relative) const noexcept -> std::byte {
+    return relative.raw < register_span ? read_table[relative.raw](impl) : unmapped_read;
+  }
+  [[nodiscard]] constexpr auto write(address /*unused*/, address relative, std::byte value) noexcept -> write_status {
+    return relative.raw < register_span ? write_table[relative.raw](impl, value) : write_status::FAILED;
+  }
+
+  // Reading `relative` has no side effect, though the value may still change on its own.
+  [[nodiscard]] static constexpr auto side_effect_free(address relative) noexcept -> bool {
+    return effect_of(relative) != register_effect::RDSE;
+  }
+  // The value of `relative` only changes through writes.
+  [[nodiscard]] static constexpr auto cacheable(address relative) noexcept -> bool {
+    return effect_of(relative) == register_effect::NONE;
+  }
+
+  // `VOLA` registers defer to `Impl::stable_until` when it exists.
+  [[nodiscard]] auto stable_until(address relative, std::uint64_t now) const noexcept -> std::uint64_t {
+    switch (effect_of(relative)) {
+      case register_effect::NONE: return std::numeric_limits<std::uint64_t>::max();
+      case register_effect::VOLA:
+        if constexpr (requires { { impl.stable_until(relative, now) } noexcept -> std::same_as<std::uint64_t>; }) {
+          return impl.stable_until(relative, now);
+        } else {
+          return now;
+        }
+      case register_effect::RDSE: return now;
+    }
+    return now;
+  }
+
+  [[nodiscard]] constexpr auto get() noexcept -> Impl & { return impl; }
+  [[nodiscard]] constexpr auto get() const noexcept -> const Impl & { return impl; }
+
+private:
+  using read_fn = auto (*)(Impl &) noexcept -> std::byte;
+  using write_fn = auto (*)(Impl &, std::byte) noexcept -> write_status;
+
+  template <auto Read>
+  static constexpr auto read_register(Impl &impl) noexcept -> std::byte {
+    if constexpr (std::is_member_object_pointer_v<decltype(Read)>) {
+      return impl.*Read;
+    } else {
+      return std::invoke(Read, impl);
+    }
+  }
+  template <auto Write>
+  static constexpr auto write_register(Impl &impl, std::byte value) noexcept -> write_status {
+    if constexpr (std::is_null_pointer_v<decltype(Write)>) {
+      return write_status::IGNORED;
+    } else if constexpr (std::is_member_object_pointer_v<decltype(Write)>) {
+      impl.*Write = value;
+      return write_status::WRITTEN;
+    } else if constexpr (std::same_as<std::invoke_result_t<decltype(Write), Impl &, std::byte>, write_status>) {
+      return std::invoke(Write, impl, value);
+    } else {
+      std::invoke(Write, impl, value);
+      return write_status::WRITTEN;
+    }
+  }
+  template <auto Read>
+  static consteval auto read_entry() -> read_fn {
+    if constexpr (std::is_null_pointer_v<decltype(Read)>) {
+      return &open_bus;
+    } else {
+      return &read_register<Read>;
+    }
+  }
+  static constexpr auto open_bus(Impl & /*unused*/) noexcept -> std::byte { return unmapped_read; }
+  static constexpr auto no_register(Impl & /*unused*/, std::byte /*unused*/) noexcept -> write_status {
+    return write_status::FAILED;
+  }
+
+  static consteval auto make_read_table() -> std::array<read_fn, register_span> {
+    auto table = std::array<read_fn, register_span>{};
+    table.fill(&open_bus);
+    ((table[Registers::offset] = read_entry<Registers::read>()), ...);
+    return table;
+  }
+  static consteval auto make_write_table() -> std::array<write_fn, register_span> {
+    auto table = std::array<write_fn, register_span>{};
+    table.fill(&no_register);
+    ((table[Registers::offset] = &write_register<Registers::write>), ...);
+    return table;
+  }
+  static consteval auto make_effect_table() -> std::array<register_effect, register_span> {
+    auto table = std::array<register_effect, register_span>{};
+    table.fill(register_effect::NONE);
+    ((table[Registers::offset] = Registers::effect), ...);
+    return table;
+  }
+
+  static constexpr auto effect_of(address relative) noexcept -> register_effect {
+    return relative.raw < register_span ? effect_table[relative.raw] : register_effect::NONE;
+  }
+
+  static constexpr auto read_table = make_read_table();
+  static constexpr auto write_table = make_write_table();
+  static constexpr auto effect_table = make_effect_table();
+
+private:
+  mutable Impl impl{};
+};
+}; // namespace erelic
@@ -0,0 +1,22 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+
+#include "address.hpp"
+
+namespace erelic {
+struct registers {
+  std::byte a{0x00};
+  std::byte x{0x00};
+  std::byte y{0x00};
+  std::byte s{0xFD};
+  std::byte p{0x24};
+  address pc{0x0000};
+
+  auto operator==(const registers &o) const noexcept -> bool = default;
+};
+}; // namespace erelic
@@ -0,0 +1,150 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <spanstream>
+#include <stdexcept>
+#include <vector>
+
+namespace erelic {
+// Deterministic machine that can be snapshotted and driven forward to a given cycle.
+template <typename T>
+concept rewindable_machine = requires(const T cm, T m, std::ostream &os, std::istream &is, std::uint64_t cycle) {
+  { cm.cycles() } noexcept -> std::same_as<std::uint64_t>;
+  { m.run_until(cycle) };
+  { cm.save_state(os) } -> std::same_as<void>;
+  { m.load_state(is) } -> std::same_as<void>;
+};
+
+// Ring of machine snapshots taken every `interval` cycles. All memory (`slots * slot_size` bytes) is allocated by the
+// constructor; recording and seeking never allocate.
+//
+// Seek bound: a binary search over the slots, one `load_state` of at most `slot_size` bytes and re-executing less than
+// `interval` cycles (plus the tail of the instruction crossing the target).
+template <rewindable_machine Machine>
+class rewind_buffer {
+public:
+  rewind_buffer(std::size_t slots, std::size_t slot_size, std::uint64_t interval)
+      : storage(storage_size(slots, slot_size, interval)), snapshots(slots), slot_size{slot_size}, interval{interval} {}
+
+  // Takes a snapshot if the machine reached the next interval boundary; call after every step or slice. The oldest
+  // snapshot is dropped when the ring is full. Throws `std::length_error` if the state does not fit a slot.
+  void record(const Machine &machine) {
+    if (machine.cycles() < next_snapshot) {
+      return;
+    }
+
+    if (count == snapshots.size()) {
+      head = (head + 1) % snapshots.size();
+      --count;
+    }
+
+    const auto index = physical(count);
+    auto os = std::ospanstream{slot_data(index)};
+    machine.save_state(os);
+    if (!os) {
+      throw std::length_error("rewind_buffer: snapshot exceeds slot size");
+    }
+
+    snapshots[index] = {.cycle = machine.cycles(), .size = os.span().size()};
+    ++count;
+    next_snapshot = (machine.cycles() / interval + 1) * interval;
+  }
+
+  // Restores the nearest snapshot at or before `cycle` and re-executes up to it. Snapshots past `cycle` are discarded,
+  // history is recorded again as the machine runs on. Returns false, leaving the machine untouched, if `cycle` is
+  // older than the oldest snapshot.
+  auto seek(Machine &machine, std::uint64_t cycle) -> bool {
+    const auto found = nearest(cycle);
+    if (!found) {
+      return false;
+    }
+
+    const auto index = physical(*found);
+    auto is = std::ispanstream{slot_data(index).first(snapshots[index].size)};
+    machine.load_state(is);
+    machine.run_until(cycle);
+
+    count = *found + 1;
+    next_snapshot = (machine.cycles() / interval + 1) * interval;
+    return true;
+  }
+
+  [[nodiscard]] auto oldest_cycle() const noexcept -> std::optional<std::uint64_t> {
+    return count == 0 ? std::nullopt : std::optional{snapshots[head].cycle};
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return count; }
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return snapshots.size(); }
+  [[nodiscard]] auto memory_budget() const noexcept -> std::size_t { return storage.size(); }
+
+  void clear() noexcept {
+    head = 0;
+    count = 0;
+    next_snapshot = 0;
+  }
+
+private:
+  struct snapshot {
+    std::uint64_t cycle = 0;
+    std::size_t size = 0;
+  };
+
+  // Validates the constructor arguments before anything is allocated.
+  [[nodiscard]] static auto storage_size(std::size_t slots, std::size_t slot_size, std::uint64_t interval)
+    -> std::size_t {
+    if (slots == 0 || slot_size == 0 || interval == 0) {
+      throw std::invalid_argument("rewind_buffer: slots, slot size and interval must be non-zero");
+    }
+    if (slot_size > std::numeric_limits<std::size_t>::max() / slots) {
+      throw std::length_error("rewind_buffer: slots times slot size overflows");
+    }
+    return slots * slot_size;
+  }
+
+  [[nodiscard]] auto physical(std::size_t logical) const noexcept -> std::size_t {
+    return (head + logical) % snapshots.size();
+  }
+
+  [[nodiscard]] auto slot_data(std::size_t index) noexcept -> std::span<char> {
+    return std::span{storage}.subspan(index * slot_size, slot_size);
+  }
+
+  // Logical index of the newest snapshot taken at or before `cycle`.
+  [[nodiscard]] auto nearest(std::uint64_t cycle) const noexcept -> std::optional<std::size_t> {
+    if (count == 0 || snapshots[head].cycle > cycle) {
+      return std::nullopt;
+    }
+    auto low = std::size_t{0};
+    auto high = count - 1;
+    while (low < high) {
+      const auto mid = (low + high + 1) / 2;
+      if (snapshots[physical(mid)].cycle <= cycle) {
+        low = mid;
+      } else {
+        high = mid - 1;
+      }
+    }
+    return low;
+  }
+
+private:
+  std::vector<char> storage;
+  std::vector<snapshot> snapshots;
+  std::size_t slot_size;
+  std::uint64_t interval;
+  std::size_t head = 0;
+  std::size_t count = 0;
+  std::uint64_t next_snapshot = 0;
+};
+}; // namespace erelic
@@ -0,0 +1,82 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "snapshot.hpp"
+
+namespace erelic {
+// Machine emulated in whole frames. With `present == false` the frame is never shown, so the machine may skip
+// producing video and audio for it.
+template <typename T>
+concept frame_machine = (snapshottable<T> || region_snapshottable<T>) && requires(T m, bool present) {
+  { m.run_frame(present) };
+};
+
+// Hides the emulated program's input lag by showing the frame `frames_ahead` frames past the real machine state.
+//
+// Restoring the snapshot and running the one real frame gives the same state as the first speculative frame, so the
+// real frame is run first (hidden) and snapshotted instead. The machine is left at the presented frame, with the states
+// of the frames between the real one and it kept in a ring of snapshots allocated once. While the input stays the
+// same the speculation was right: a host frame then costs one presented frame and one capture, and the real state
+// moves one slot along the ring. When the input changes, the real state is restored and `frames_ahead` frames are run
+// again, capturing each hidden one.
+template <frame_machine Machine>
+class run_ahead {
+public:
+  run_ahead(std::size_t frames_ahead, std::size_t state_capacity) : frames{frames_ahead}, capacity{state_capacity} {}
+
+  // Advances `machine` by one real frame using the input already applied to it. `input_changed` tells whether that
+  // input differs from the one applied before the previous call.
+  void run_frame(Machine &machine, bool input_changed = true) {
+    if (frames <= 1) {
+      sync(machine);
+      machine.run_frame(true);
+      return;
+    }
+    if (ahead && !input_changed && ring.size() == frames - 1) {
+      ring[oldest].capture(machine);
+      oldest = (oldest + 1) % ring.size();
+      machine.run_frame(true);
+      return;
+    }
+
+    sync(machine);
+    if (ring.size() != frames - 1) {
+      ring.assign(frames - 1, state_snapshot{capacity});
+    }
+    for (auto &snapshot : ring) {
+      machine.run_frame(false);
+      snapshot.capture(machine);
+    }
+    oldest = 0;
+    ahead = true;
+    machine.run_frame(true);
+  }
+
+  // Brings `machine` back from the presented frame to the real state, e.g. before saving or inspecting it. The next
+  // `run_frame` runs every frame again.
+  void sync(Machine &machine) {
+    if (ahead) {
+      ring[oldest].restore(machine);
+      ahead = false;
+    }
+  }
+
+  [[nodiscard]] auto frames_ahead() const noexcept -> std::size_t { return frames; }
+  // Takes effect at the next `run_frame`, which restores the real state first.
+  void set_frames_ahead(std::size_t frames_ahead) noexcept { frames = frames_ahead; }
+
+private:
+  std::size_t frames;
+  std::size_t capacity;
+  std::vector<state_snapshot> ring;
+  // Slot holding the real state while `ahead`.
+  std::size_t oldest = 0;
+  bool ahead = false;
+};
+}; // namespace erelic
@@ -0,0 +1,235 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "savestate.hpp"
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <spanstream>
+#include <streambuf>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "registers.hpp"
+
+namespace {
+using namespace erelic;
+
+constexpr auto magic = std::array{'E', 'R', 'S', 'T'};
+constexpr auto version = std::uint8_t{2};
+
+template <std::unsigned_integral T>
+void put(std::ostream &os, T value) {
+  auto bytes = std::array<char, sizeof(T)>{};
+  for (auto &byte : bytes) {
+    byte = static_cast<char>(value & 0xFFU);
+    value = static_cast<T>(value >> 8U);
+  }
+  os.write(bytes.data(), bytes.size());
+}
+
+void put(std::ostream &os, std::byte value) { put(os, std::to_integer<std::uint8_t>(value)); }
+
+template <std::unsigned_integral T>
+auto get(std::istream &is) -> T {
+  auto bytes = std::array<char, sizeof(T)>{};
+  if (!is.read(bytes.data(), bytes.size())) {
+    throw std::runtime_error("savestate: unexpected end of stream");
+  }
+  auto value = T{0};
+  for (auto i = sizeof(T); i > 0; --i) {
+    value = static_cast<T>((value << 8U) | std::bit_cast<std::uint8_t>(bytes[i - 1]));
+  }
+  return value;
+}
+
+auto get_byte(std::istream &is) -> std::byte { return std::byte{get<std::uint8_t>(is)}; }
+
+// Largest device state accepted on read, so a corrupt length cannot request an arbitrary allocation.
+constexpr auto max_device_state = std::uint32_t{1} << 24U;
+
+void put_page(std::ostream &os, std::size_t page, std::span<const std::byte> bytes) {
+  put(os, static_cast<std::uint8_t>(page));
+  for (const auto byte : bytes) {
+    put(os, byte);
+  }
+}
+
+// Counts the bytes written through it and drops them.
+class counting_buffer : public std::streambuf {
+public:
+  [[nodiscard]] auto count() const noexcept -> std::streamsize { return written; }
+
+protected:
+  auto overflow(int_type c) -> int_type override {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      ++written;
+    }
+    return traits_type::not_eof(c);
+  }
+  auto xsputn(const char * /*unused*/, std::streamsize n) -> std::streamsize override {
+    written += n;
+    return n;
+  }
+
+private:
+  std::streamsize written = 0;
+};
+
+void put_device(std::ostream &os, const bus &b, std::size_t index) {
+  auto counter = counting_buffer{};
+  auto measure = std::ostream{&counter};
+  b.save_device_state(index, measure);
+  if (counter.count() > max_device_state) {
+    throw std::length_error("savestate: device state too large");
+  }
+  put(os, static_cast<std::uint32_t>(counter.count()));
+  b.save_device_state(index, os);
+}
+}; // namespace
+
+namespace erelic {
+auto operator<<(std::ostream &os, const savestate_kind &k) -> std::ostream & {
+  switch (k) {
+    case savestate_kind::KEYFRAME: os << "KEYFRAME"; break;
+    case savestate_kind::DELTA: os << "DELTA"; break;
+  }
+  return os;
+}
+
+savestate_writer::savestate_writer(std::size_t deltas_per_keyframe) noexcept
+    : deltas_per_keyframe{deltas_per_keyframe}, deltas_since_keyframe{0} {}
+
+auto savestate_writer::write(std::ostream &os, const registers &regs, bus &b) -> savestate_kind {
+  const auto kind = keyframe_pending || deltas_since_keyframe >= deltas_per_keyframe ? savestate_kind::KEYFRAME
+                                                                                     : savestate_kind::DELTA;
+  auto pages = b.dirty_pages();
+  if (kind == savestate_kind::KEYFRAME) {
+    pages.set();
+    deltas_since_keyframe = 0;
+    keyframe_pending = false;
+  } else {
+    ++deltas_since_keyframe;
+  }
+
+  os.write(magic.data(), magic.size());
+  put(os, version);
+  put(os, static_cast<std::uint8_t>(kind));
+
+  put(os, regs.a);
+  put(os, regs.x);
+  put(os, regs.y);
+  put(os, regs.s);
+  put(os, regs.p);
+  put(os, regs.pc.raw);
+
+  for (auto page = std::size_t{0}; page < page_count; ++page) {
+    if (pages.test(page) && b.page_memory(page).empty()) {
+      pages.reset(page);
+    }
+  }
+  put(os, static_cast<std::uint16_t>(pages.count()));
+  for (auto page = std::size_t{0}; page < page_count; ++page) {
+    if (pages.test(page)) {
+      put_page(os, page, b.page_memory(page));
+    }
+  }
+
+  put(os, static_cast<std::uint16_t>(b.device_count()));
+  for (auto index = std::size_t{0}; index < b.device_count(); ++index) {
+    put_device(os, b, index);
+  }
+
+  b.clear_dirty_pages();
+  return kind;
+}
+
+void savestate_writer::restart() noexcept { keyframe_pending = true; }
+
+savestate_reader::savestate_reader() : pages(page_count) {}
+
+void savestate_reader::parse(std::istream &is, bus &b) {
+  auto header = std::array<char, magic.size()>{};
+  if (!is.read(header.data(), header.size()) || header != magic) {
+    throw std::runtime_error("savestate: bad magic");
+  }
+  if (get<std::uint8_t>(is) != version) {
+    throw std::runtime_error("savestate: unsupported version");
+  }
+  const auto kind = get<std::uint8_t>(is);
+  if (kind > static_cast<std::uint8_t>(savestate_kind::DELTA)) {
+    throw std::runtime_error("savestate: unknown state kind");
+  }
+
+  parsed_kind = static_cast<savestate_kind>(kind);
+  parsed_regs.a = get_byte(is);
+  parsed_regs.x = get_byte(is);
+  parsed_regs.y = get_byte(is);
+  parsed_regs.s = get_byte(is);
+  parsed_regs.p = get_byte(is);
+  parsed_regs.pc = address{get<std::uint16_t>(is)};
+
+  page_records = get<std::uint16_t>(is);
+  if (page_records > page_count) {
+    throw std::runtime_error("savestate: bad page count");
+  }
+  for (auto &record : std::span{pages}.first(page_records)) {
+    record.page = get<std::uint8_t>(is);
+    if (b.page_memory(record.page).empty()) {
+      throw std::runtime_error("savestate: page not backed by memory");
+    }
+    for (auto &byte : record.bytes) {
+      byte = get_byte(is);
+    }
+  }
+
+  if (get<std::uint16_t>(is) != b.device_count()) {
+    throw std::runtime_error("savestate: device layout mismatch");
+  }
+  device_states.clear();
+  device_ends.clear();
+  for (auto index = std::size_t{0}; index < b.device_count(); ++index) {
+    const auto size = get<std::uint32_t>(is);
+    if (size > max_device_state) {
+      throw std::runtime_error("savestate: device state too large");
+    }
+    const auto offset = device_states.size();
+    device_states.resize(offset + size);
+    if (!is.read(device_states.data() + offset, static_cast<std::streamsize>(size))) {
+      throw std::runtime_error("savestate: truncated device state");
+    }
+    device_ends.push_back(device_states.size());
+  }
+}
+
+auto savestate_reader::read(std::istream &is, registers &regs, bus &b) -> savestate_kind {
+  parse(is, b);
+
+  for (const auto &record : std::span{pages}.first(page_records)) {
+    (void)b.load_page(record.page, record.bytes);
+  }
+  auto offset = std::size_t{0};
+  for (auto index = std::size_t{0}; index < device_ends.size(); ++index) {
+    auto device = std::ispanstream{std::span{device_states}.subspan(offset, device_ends[index] - offset)};
+    b.load_device_state(index, device);
+    if (!device) {
+      throw std::runtime_error("savestate: device rejected its state");
+    }
+    offset = device_ends[index];
+  }
+
+  regs = parsed_regs;
+  b.clear_dirty_pages();
+  return parsed_kind;
+}
+}; // namespace erelic
@@ -0,0 +1,81 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "bus.hpp"
+#include "registers.hpp"
+
+namespace erelic {
+// Binary layout, integers are little-endian:
+//   "ERST" | version:u8 | kind:u8 | a, x, y, s, p:u8 | pc:u16 | page count:u16 | { page:u8 | 256 bytes } * page count |
+//   device count:u16 | { size:u32 | device state } * device count
+// Only pages backed by a `memory_device` are stored: a keyframe carries all of them, a delta the ones dirtied since
+// the previous state of the chain. Every other device, including memory-mapped I/O, is left to its own state, so
+// saving and restoring never trigger device read or write side effects.
+enum class savestate_kind : std::uint8_t {
+  KEYFRAME,
+  DELTA,
+};
+
+auto operator<<(std::ostream &os, const savestate_kind &k) -> std::ostream &;
+
+// Streams states straight into `os`: writing allocates nothing beyond what `os` itself does. The size prefix of a
+// device state is taken by saving it once into a counting stream, so `save_state` runs twice per device and must
+// write the same bytes both times. Throws `std::length_error` if a device state exceeds the readable limit of 16 MiB.
+class savestate_writer {
+public:
+  // Writes a keyframe first and then after every `deltas_per_keyframe` deltas.
+  explicit savestate_writer(std::size_t deltas_per_keyframe) noexcept;
+
+  // Writes the next state of the chain and clears the dirty pages of `b`.
+  auto write(std::ostream &os, const registers &regs, bus &b) -> savestate_kind;
+
+  // Makes the next state a keyframe, e.g. after the machine was restored from elsewhere.
+  void restart() noexcept;
+
+private:
+  std::size_t deltas_per_keyframe;
+  std::size_t deltas_since_keyframe;
+  bool keyframe_pending = true;
+};
+
+// Applies states of a chain: a keyframe on any machine with the same memory map, a delta on top of the state it
+// follows. The page records are checked in a buffer for every page, allocated by the constructor, and device states
+// are kept in a buffer that only grows; once a state of the same shape was read, reading allocates nothing beyond
+// what `is` itself does.
+class savestate_reader {
+public:
+  savestate_reader();
+
+  // Clears the dirty pages of `b`. The whole state is read and checked first; malformed input throws
+  // `std::runtime_error` and leaves the machine untouched. Past that point only a device failing to load its own
+  // state throws, after the memory pages were restored.
+  auto read(std::istream &is, registers &regs, bus &b) -> savestate_kind;
+
+private:
+  struct page_record {
+    std::size_t page = 0;
+    std::array<std::byte, page_size> bytes{};
+  };
+
+  void parse(std::istream &is, bus &b);
+
+private:
+  savestate_kind parsed_kind = savestate_kind::KEYFRAME;
+  registers parsed_regs{};
+  std::vector<page_record> pages;
+  std::size_t page_records = 0;
+  std::vector<char> device_states{};
+  // End offset of each device state in `device_states`.
+  std::vector<std::size_t> device_ends{};
+};
+}; // namespace erelic
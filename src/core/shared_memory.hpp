@@ -0,0 +1,160 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "address.hpp"
+#include "device.hpp"
+
+namespace erelic {
+// Memory shared by several CPUs that run their quanta in parallel. Each CPU maps its own `port`, whose clock must be
+// the cycle at which the CPU started its current instruction. Within a quantum a CPU sees the contents committed at
+// the last barrier plus its own writes; writes of the other CPUs become visible at the next `commit`, applied in
+// (cycle, CPU index) order. What a CPU observes therefore depends only on the quantum schedule, never on how host
+// threads interleave.
+//
+// Running one cycle per quantum, a read sees every write of the other CPUs from earlier cycles. A longer quantum gives
+// the same result unless a CPU read a cell another CPU wrote earlier in the same quantum; `first_conflict` finds the
+// earliest such write, so the scheduler can `discard` the quantum and run it again up to that write.
+//
+// Each CPU keeps an overlay of its accesses per cell, so reads are constant time. Only the last write of each CPU to
+// a cell can decide the committed value, hence the lists of cells a CPU read or wrote in a quantum never exceed `Size`
+// and are allocated once: accesses never allocate.
+template <std::size_t Size>
+class shared_memory {
+public:
+  class port {
+  public:
+    [[nodiscard]] auto read(address /*unused*/, address relative) const noexcept -> std::byte {
+      const auto index = relative.raw % Size;
+      auto &own = owner->overlay[cpu * Size + index];
+      if (!own.read) {
+        own.read = true;
+        owner->reads[cpu].push_back(index);
+      }
+      own.last_read = *clock;
+      return own.written ? own.value : owner->cells[index];
+    }
+    [[nodiscard]] auto write(address /*unused*/, address relative, std::byte value) noexcept -> write_status {
+      const auto index = relative.raw % Size;
+      auto &own = owner->overlay[cpu * Size + index];
+      if (!own.written) {
+        own.written = true;
+        own.first_write = *clock;
+        owner->writes[cpu].push_back(index);
+      }
+      own.last_write = *clock;
+      own.value = value;
+      return write_status::WRITTEN;
+    }
+
+  private:
+    friend class shared_memory;
+    port(shared_memory &owner, std::size_t cpu, const std::uint64_t &clock) noexcept
+        : owner{&owner}, cpu{cpu}, clock{&clock} {}
+
+    shared_memory *owner;
+    std::size_t cpu;
+    const std::uint64_t *clock;
+  };
+
+  explicit shared_memory(std::size_t cpu_count) : overlay(cpu_count * Size), reads(cpu_count), writes(cpu_count) {
+    for (auto &cells_of_cpu : reads) {
+      cells_of_cpu.reserve(Size);
+    }
+    for (auto &cells_of_cpu : writes) {
+      cells_of_cpu.reserve(Size);
+    }
+    merged.reserve(cpu_count * Size);
+  }
+
+  // Port of CPU `cpu`, stamping its accesses with the current value of `clock`.
+  [[nodiscard]] auto port_for(std::size_t cpu, const std::uint64_t &clock) noexcept -> port {
+    return port{*this, cpu, clock};
+  }
+
+  // One past the earliest write of the finished quantum that another CPU read later in it, i.e. where the quantum has
+  // to end to give the one-cycle result; nothing if it already does. Call only while all CPUs are stopped.
+  [[nodiscard]] auto first_conflict() const noexcept -> std::optional<std::uint64_t> {
+    auto end = std::optional<std::uint64_t>{};
+    for (std::size_t reader = 0; reader < reads.size(); ++reader) {
+      for (const auto index : reads[reader]) {
+        const auto read_at = overlay[reader * Size + index].last_read;
+        for (std::size_t writer = 0; writer < writes.size(); ++writer) {
+          const auto &w = overlay[writer * Size + index];
+          if (writer != reader && w.written && w.first_write < read_at) {
+            end = std::min(end.value_or(w.first_write + 1), w.first_write + 1);
+          }
+        }
+      }
+    }
+    return end;
+  }
+
+  // Applies the writes of the finished quantum; returns whether there were any. Call only while all CPUs are stopped.
+  auto commit() -> bool {
+    merged.clear();
+    for (std::size_t cpu = 0; cpu < writes.size(); ++cpu) {
+      for (const auto index : writes[cpu]) {
+        const auto &own = overlay[cpu * Size + index];
+        merged.push_back({own.last_write, cpu, index, own.value});
+      }
+    }
+    std::ranges::sort(merged, {}, [](const pending_write &w) { return std::pair{w.cycle, w.cpu}; });
+    for (const auto &w : merged) {
+      cells[w.index] = w.value;
+    }
+    discard();
+    return !merged.empty();
+  }
+
+  // Drops the accesses of the finished quantum, e.g. to run it again. Call only while all CPUs are stopped.
+  void discard() noexcept {
+    for (std::size_t cpu = 0; cpu < writes.size(); ++cpu) {
+      for (const auto index : writes[cpu]) {
+        overlay[cpu * Size + index].written = false;
+      }
+      for (const auto index : reads[cpu]) {
+        overlay[cpu * Size + index].read = false;
+      }
+      writes[cpu].clear();
+      reads[cpu].clear();
+    }
+  }
+
+  [[nodiscard]] auto contents() const noexcept -> const std::array<std::byte, Size> & { return cells; }
+
+private:
+  struct overlay_cell {
+    std::uint64_t first_write = 0;
+    std::uint64_t last_write = 0;
+    std::uint64_t last_read = 0;
+    std::byte value{};
+    bool written = false;
+    bool read = false;
+  };
+
+  struct pending_write {
+    std::uint64_t cycle;
+    std::size_t cpu;
+    std::size_t index;
+    std::byte value;
+  };
+
+private:
+  std::array<std::byte, Size> cells{};
+  std::vector<overlay_cell> overlay;
+  std::vector<std::vector<std::size_t>> reads;
+  std::vector<std::vector<std::size_t>> writes;
+  std::vector<pending_write> merged;
+};
+}; // namespace erelic
@@ -0,0 +1,98 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <spanstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace erelic {
+template <typename T>
+concept snapshottable = requires(const T cm, T m, std::ostream &os, std::istream &is) {
+  { cm.save_state(os) } -> std::same_as<void>;
+  { m.load_state(is) } -> std::same_as<void>;
+};
+
+// Machine whose bulk state lives in fixed memory regions, e.g. the `memory()` of its `memory_device`s, copied as raw
+// bytes. `save_register_state` and `load_register_state` stream everything outside the regions: CPU registers and the
+// state of devices without memory. The regions must keep their sizes between a capture and its restores.
+template <typename T>
+concept region_snapshottable = requires(const T cm, T m, std::ostream &os, std::istream &is) {
+  { m.state_regions() } -> std::ranges::input_range;
+  requires std::convertible_to<std::ranges::range_reference_t<decltype(m.state_regions())>, std::span<std::byte>>;
+  { cm.save_register_state(os) } -> std::same_as<void>;
+  { m.load_register_state(is) } -> std::same_as<void>;
+};
+
+// Machine state kept in a buffer allocated once; capturing and restoring only copy the device states in and out.
+// Regions of a `region_snapshottable` machine are copied with `memcpy`, only the rest goes through a stream.
+class state_snapshot {
+public:
+  explicit state_snapshot(std::size_t capacity) : buffer(capacity) {}
+
+  // Throws `std::length_error` if the state does not fit the capacity.
+  template <typename T>
+    requires snapshottable<std::remove_const_t<T>> || region_snapshottable<std::remove_const_t<T>>
+  void capture(T &machine) {
+    used = 0;
+    auto offset = std::size_t{0};
+    auto os = std::ospanstream{std::span{buffer}};
+    if constexpr (region_snapshottable<std::remove_const_t<T>>) {
+      static_assert(!std::is_const_v<T>, "state_snapshot: regions are captured from a mutable machine");
+      for (const std::span<std::byte> region : machine.state_regions()) {
+        if (region.size() > buffer.size() - offset) {
+          throw std::length_error("state_snapshot: state exceeds capacity");
+        }
+        std::memcpy(buffer.data() + offset, region.data(), region.size());
+        offset += region.size();
+      }
+      os.span(std::span{buffer}.subspan(offset));
+      machine.save_register_state(os);
+    } else {
+      machine.save_state(os);
+    }
+    if (!os) {
+      throw std::length_error("state_snapshot: state exceeds capacity");
+    }
+    used = offset + os.span().size();
+  }
+
+  // Throws `std::logic_error` if the regions grew since the capture.
+  template <typename T>
+    requires snapshottable<T> || region_snapshottable<T>
+  void restore(T &machine) const {
+    auto offset = std::size_t{0};
+    if constexpr (region_snapshottable<T>) {
+      for (const std::span<std::byte> region : machine.state_regions()) {
+        if (region.size() > used - offset) {
+          throw std::logic_error("state_snapshot: regions do not match the captured state");
+        }
+        std::memcpy(region.data(), buffer.data() + offset, region.size());
+        offset += region.size();
+      }
+      auto is = std::ispanstream{std::span{buffer}.subspan(offset, used - offset)};
+      machine.load_register_state(is);
+    } else {
+      auto is = std::ispanstream{std::span{buffer}.first(used)};
+      machine.load_state(is);
+    }
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return used; }
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return buffer.size(); }
+
+private:
+  std::vector<char> buffer;
+  std::size_t used = 0;
+};
+}; // namespace erelic
@@ -0,0 +1,65 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+namespace erelic {
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+template <typename T, std::size_t Capacity>
+  requires(std::has_single_bit(Capacity) && std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>)
+class spsc_queue {
+public:
+  // Producer side. Returns false if the queue is full.
+  auto try_push(const T &value) noexcept -> bool {
+    const auto tail = write_index.load(std::memory_order_relaxed);
+    if (tail - cached_read_index == Capacity) {
+      cached_read_index = read_index.load(std::memory_order_acquire);
+      if (tail - cached_read_index == Capacity) {
+        return false;
+      }
+    }
+    slots[tail & mask] = value;
+    write_index.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Returns `std::nullopt` if the queue is empty.
+  auto try_pop() noexcept -> std::optional<T> {
+    const auto head = read_index.load(std::memory_order_relaxed);
+    if (head == cached_write_index) {
+      cached_write_index = write_index.load(std::memory_order_acquire);
+      if (head == cached_write_index) {
+        return std::nullopt;
+      }
+    }
+    const auto value = slots[head & mask];
+    read_index.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool {
+    return read_index.load(std::memory_order_acquire) == write_index.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] static constexpr auto capacity() noexcept -> std::size_t { return Capacity; }
+
+private:
+  static constexpr auto mask = Capacity - 1;
+  static constexpr auto cache_line = std::size_t{64};
+
+  // Producer-owned and consumer-owned indices live on separate cache lines, each next to its cached copy of the other.
+  alignas(cache_line) std::atomic<std::size_t> write_index{0};
+  std::size_t cached_read_index = 0;
+  alignas(cache_line) std::atomic<std::size_t> read_index{0};
+  std::size_t cached_write_index = 0;
+  alignas(cache_line) std::array<T, Capacity> slots{};
+};
+}; // namespace erelic
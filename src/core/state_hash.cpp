@@ -0,0 +1,104 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "state_hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace erelic {
+namespace {
+constexpr auto register_slot = static_cast<std::uint32_t>(address_space_size);
+
+auto register_fields(const registers &cpu) noexcept -> std::array<std::byte, 7> {
+  return {cpu.a, cpu.x, cpu.y, cpu.s, cpu.p, cpu.pc.bytes[0], cpu.pc.bytes[1]};
+}
+
+auto register_key(const registers &cpu) noexcept -> std::uint64_t {
+  const auto fields = register_fields(cpu);
+  auto key = std::uint64_t{0};
+  for (auto i = std::uint32_t{0}; i < fields.size(); ++i) {
+    key ^= zobrist_key(register_slot + i, fields[i]);
+  }
+  return key;
+}
+}; // namespace
+
+state_hash::state_hash() noexcept {
+  for (auto slot = std::uint32_t{0}; slot < address_space_size; ++slot) {
+    memory_hash ^= zobrist_key(slot, std::byte{0x00});
+  }
+  register_hash = register_key(regs);
+}
+
+state_hash::state_hash(std::span<const std::byte, address_space_size> memory, const registers &cpu) noexcept {
+  std::ranges::copy(memory, shadow.begin());
+  for (auto slot = std::uint32_t{0}; slot < address_space_size; ++slot) {
+    memory_hash ^= zobrist_key(slot, shadow[slot]);
+  }
+  regs = cpu;
+  register_hash = register_key(cpu);
+}
+
+void state_hash::write(address absolute, std::byte value) noexcept {
+  auto &cell = shadow[absolute.raw];
+  memory_hash ^= zobrist_key(absolute.raw, cell) ^ zobrist_key(absolute.raw, value);
+  cell = value;
+}
+
+void state_hash::set_registers(const registers &cpu) noexcept {
+  const auto before = register_fields(regs);
+  const auto after = register_fields(cpu);
+  for (auto i = std::uint32_t{0}; i < after.size(); ++i) {
+    if (before[i] != after[i]) {
+      register_hash ^= zobrist_key(register_slot + i, before[i]) ^ zobrist_key(register_slot + i, after[i]);
+    }
+  }
+  regs = cpu;
+}
+
+auto state_hash::operator==(const state_hash &o) const noexcept -> bool {
+  return value() == o.value() && regs == o.regs && shadow == o.shadow;
+}
+
+state_set::state_set(bool exact) noexcept : exact{exact} {}
+
+auto state_set::matches(const stored &s, const state_hash &state) noexcept -> bool {
+  return s.cpu == state.cpu() && std::ranges::equal(s.memory, state.memory());
+}
+
+auto state_set::insert(const state_hash &state) -> bool {
+  auto [it, inserted] = seen.try_emplace(state.value());
+  if (!exact) {
+    count += inserted ? 1 : 0;
+    return !inserted;
+  }
+  auto &bucket = it->second;
+  if (std::ranges::any_of(bucket, [&](const stored &s) { return matches(s, state); })) {
+    return true;
+  }
+  bucket.push_back({state.cpu(), {state.memory().begin(), state.memory().end()}});
+  ++count;
+  return false;
+}
+
+auto state_set::contains(const state_hash &state) const -> bool {
+  const auto it = seen.find(state.value());
+  if (it == seen.end()) {
+    return false;
+  }
+  return !exact || std::ranges::any_of(it->second, [&](const stored &s) { return matches(s, state); });
+}
+
+auto state_set::size() const noexcept -> std::size_t { return count; }
+
+void state_set::clear() noexcept {
+  seen.clear();
+  count = 0;
+}
+}; // namespace erelic
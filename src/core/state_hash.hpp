@@ -0,0 +1,81 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "address.hpp"
+#include "registers.hpp"
+
+namespace erelic {
+// Zobrist key of `value` held in `slot`: slots below `address_space_size` are memory cells, the ones above are CPU
+// registers. Keys are derived with the splitmix64 finalizer instead of being tabulated; a full table would take
+// 128 MiB.
+constexpr auto zobrist_key(std::uint32_t slot, std::byte value) noexcept -> std::uint64_t {
+  auto z = ((std::uint64_t{slot} << 8U) | std::to_integer<std::uint64_t>(value)) * 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31U);
+}
+
+// Incremental hash of the machine state, i.e. the CPU registers and the last value written to every address. Each
+// write and register update costs O(1), so `value` is current at every instruction boundary. A shadow copy of memory
+// provides the old value a write replaces and backs the exact comparison; the object is over 64 KiB, keep it off the
+// stack.
+class state_hash {
+public:
+  // All-zero memory and power-on registers.
+  state_hash() noexcept;
+  explicit state_hash(std::span<const std::byte, address_space_size> memory, const registers &cpu = {}) noexcept;
+
+  void write(address absolute, std::byte value) noexcept;
+  void set_registers(const registers &cpu) noexcept;
+
+  [[nodiscard]] auto value() const noexcept -> std::uint64_t { return memory_hash ^ register_hash; }
+  [[nodiscard]] auto memory() const noexcept -> std::span<const std::byte, address_space_size> { return shadow; }
+  [[nodiscard]] auto cpu() const noexcept -> const registers & { return regs; }
+
+  // Exact comparison, to confirm a match of `value`.
+  [[nodiscard]] auto operator==(const state_hash &o) const noexcept -> bool;
+
+private:
+  std::array<std::byte, address_space_size> shadow{};
+  registers regs;
+  std::uint64_t memory_hash = 0;
+  std::uint64_t register_hash = 0;
+};
+
+// States seen so far, for loop and duplicate detection. By default equal hashes count as equal states; with `exact`
+// every inserted state is copied and hash matches are confirmed byte by byte, at 64 KiB per distinct state.
+class state_set {
+public:
+  explicit state_set(bool exact = false) noexcept;
+
+  // True if `state` was inserted before.
+  auto insert(const state_hash &state) -> bool;
+  [[nodiscard]] auto contains(const state_hash &state) const -> bool;
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+  void clear() noexcept;
+
+private:
+  struct stored {
+    registers cpu;
+    std::vector<std::byte> memory;
+  };
+
+  [[nodiscard]] static auto matches(const stored &s, const state_hash &state) noexcept -> bool;
+
+private:
+  bool exact;
+  std::size_t count = 0;
+  std::unordered_map<std::uint64_t, std::vector<stored>> seen;
+};
+}; // namespace erelic
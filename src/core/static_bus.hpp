@@ -0,0 +1,131 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+
+namespace erelic {
+// Device bound to a fixed address range of a `static_bus`.
+template <address_range Range, io_device Device>
+struct mapping {
+  static constexpr auto range = Range;
+
+  Device device;
+
+  [[nodiscard]] static constexpr auto contains(address absolute) noexcept -> bool {
+    return Range.from.raw <= absolute.raw && absolute.raw <= Range.till.raw;
+  }
+  [[nodiscard]] static constexpr auto relative(address absolute) noexcept -> address {
+    return address{static_cast<address_raw>(absolute.raw - Range.from.raw)};
+  }
+};
+
+template <typename T>
+concept static_mapping = requires {
+  { T::range } -> std::convertible_to<address_range>;
+} && io_device<decltype(T::device)> && std::same_as<T, mapping<T::range, decltype(T::device)>>;
+
+template <static_mapping... Mappings>
+consteval auto disjoint_mappings() -> bool {
+  const auto ranges = std::array<address_range, sizeof...(Mappings)>{Mappings::range...};
+  for (std::size_t i = 0; i < ranges.size(); ++i) {
+    for (std::size_t j = i + 1; j < ranges.size(); ++j) {
+      if (ranges[i].overlaps(ranges[j])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Bus whose memory map is fixed at compile time: no type erasure, the target device is resolved by a chain of
+// constant range checks and its `read`/`write` can be inlined.
+template <static_mapping... Mappings>
+  requires(disjoint_mappings<Mappings...>())
+class static_bus {
+public:
+  constexpr static_bus() = default;
+  constexpr explicit static_bus(Mappings... m) : mappings{std::move(m)...} {}
+
+  [[nodiscard]] constexpr auto read(address absolute) const noexcept -> std::byte { return read_from<0>(absolute); }
+  [[nodiscard]] constexpr auto write(address absolute, std::byte value) noexcept -> write_status {
+    return write_to<0>(absolute, value);
+  }
+
+  // See `bus::bind_page`.
+  [[nodiscard]] constexpr auto bind_page(std::size_t page) noexcept -> std::span<std::byte> {
+    return bind_from<0>(page);
+  }
+
+  template <std::size_t I>
+  [[nodiscard]] constexpr auto get() noexcept -> auto & {
+    return std::get<I>(mappings).device;
+  }
+  template <std::size_t I>
+  [[nodiscard]] constexpr auto get() const noexcept -> const auto & {
+    return std::get<I>(mappings).device;
+  }
+
+private:
+  template <std::size_t I>
+  [[nodiscard]] constexpr auto read_from(address absolute) const noexcept -> std::byte {
+    if constexpr (I == sizeof...(Mappings)) {
+      return unmapped_read;
+    } else {
+      using mapping_type = std::tuple_element_t<I, std::tuple<Mappings...>>;
+      if (mapping_type::contains(absolute)) {
+        return std::get<I>(mappings).device.read(absolute, mapping_type::relative(absolute));
+      }
+      return read_from<I + 1>(absolute);
+    }
+  }
+
+  template <std::size_t I>
+  [[nodiscard]] constexpr auto write_to(address absolute, std::byte value) noexcept -> write_status {
+    if constexpr (I == sizeof...(Mappings)) {
+      return write_status::FAILED;
+    } else {
+      using mapping_type = std::tuple_element_t<I, std::tuple<Mappings...>>;
+      if (mapping_type::contains(absolute)) {
+        return std::get<I>(mappings).device.write(absolute, mapping_type::relative(absolute), value);
+      }
+      return write_to<I + 1>(absolute, value);
+    }
+  }
+
+  template <std::size_t I>
+  [[nodiscard]] constexpr auto bind_from(std::size_t page) noexcept -> std::span<std::byte> {
+    if constexpr (I == sizeof...(Mappings)) {
+      return {};
+    } else {
+      using mapping_type = std::tuple_element_t<I, std::tuple<Mappings...>>;
+      if constexpr (memory_device<decltype(mapping_type::device)>) {
+        const auto first = address{static_cast<address_raw>(page * page_size)};
+        const auto last = address{static_cast<address_raw>(first.raw + page_size - 1)};
+        if (mapping_type::contains(first) && mapping_type::contains(last)) {
+          const auto memory = std::get<I>(mappings).device.memory();
+          const auto offset = mapping_type::relative(first).raw;
+          if (memory.size() >= offset + page_size) {
+            return memory.subspan(offset, page_size);
+          }
+        }
+      }
+      return bind_from<I + 1>(page);
+    }
+  }
+
+private:
+  std::tuple<Mappings...> mappings;
+};
+}; // namespace erelic
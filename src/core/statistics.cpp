@@ -0,0 +1,55 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "statistics.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace erelic {
+statistics::statistics(std::size_t device_count) : cells(core_cells + device_count * device_cells) {}
+
+void statistics::publish(const core_counts &core, std::span<const device_counts> devices) noexcept {
+  const auto seq = sequence.load(std::memory_order_relaxed);
+  sequence.store(seq + 1, std::memory_order_relaxed);
+
+  cells[0].store(core.cycles, std::memory_order_release);
+  cells[1].store(core.instructions, std::memory_order_release);
+  cells[2].store(core.interrupts, std::memory_order_release);
+  const auto count = std::min(devices.size(), (cells.size() - core_cells) / device_cells);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto cell = core_cells + i * device_cells;
+    cells[cell++].store(devices[i].reads, std::memory_order_release);
+    for (const auto writes : devices[i].writes) {
+      cells[cell++].store(writes, std::memory_order_release);
+    }
+  }
+
+  sequence.store(seq + 2, std::memory_order_release);
+}
+
+auto statistics::snapshot() const -> statistics_snapshot {
+  auto result = statistics_snapshot{};
+  result.devices.resize((cells.size() - core_cells) / device_cells);
+  while (true) {
+    const auto before = sequence.load(std::memory_order_acquire);
+    if (before % 2 == 0) {
+      result.core.cycles = cells[0].load(std::memory_order_acquire);
+      result.core.instructions = cells[1].load(std::memory_order_acquire);
+      result.core.interrupts = cells[2].load(std::memory_order_acquire);
+      auto cell = core_cells;
+      for (auto &dev : result.devices) {
+        dev.reads = cells[cell++].load(std::memory_order_acquire);
+        for (auto &writes : dev.writes) {
+          writes = cells[cell++].load(std::memory_order_acquire);
+        }
+      }
+      if (sequence.load(std::memory_order_relaxed) == before) {
+        result.generation = before / 2;
+        return result;
+      }
+    }
+  }
+}
+}; // namespace erelic
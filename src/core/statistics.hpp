@@ -0,0 +1,68 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "device.hpp"
+
+namespace erelic {
+// Counters of the CPU core. Owned and incremented by the emulation thread only, so they are plain integers.
+struct core_counts {
+  std::uint64_t cycles = 0;
+  std::uint64_t instructions = 0;
+  std::uint64_t interrupts = 0;
+
+  auto operator==(const core_counts &o) const noexcept -> bool = default;
+};
+
+constexpr auto write_status_count = std::size_t{3};
+
+// Accesses routed to one device, writes broken down by the returned `write_status`.
+struct device_counts {
+  std::uint64_t reads = 0;
+  std::array<std::uint64_t, write_status_count> writes{};
+
+  void count(write_status status) noexcept { ++writes[static_cast<std::size_t>(status)]; }
+  [[nodiscard]] auto writes_with(write_status status) const noexcept -> std::uint64_t {
+    return writes[static_cast<std::size_t>(status)];
+  }
+
+  auto operator==(const device_counts &o) const noexcept -> bool = default;
+};
+
+struct statistics_snapshot {
+  core_counts core;
+  std::vector<device_counts> devices;
+  // Number of `publish` calls the snapshot reflects.
+  std::uint64_t generation = 0;
+};
+
+// Publication point between the emulation thread, which keeps counting in plain integers and calls `publish` once per
+// slice or frame, and any number of monitoring threads calling `snapshot`. A sequence lock over release/acquire
+// atomics (plain moves on x86) makes every snapshot consistent, all counters coming from the same `publish`, without
+// ever blocking the emulation thread.
+class statistics {
+public:
+  explicit statistics(std::size_t device_count);
+
+  // Single writer. Devices beyond the count given at construction are dropped.
+  void publish(const core_counts &core, std::span<const device_counts> devices) noexcept;
+  [[nodiscard]] auto snapshot() const -> statistics_snapshot;
+
+private:
+  static constexpr std::size_t core_cells = 3;
+  static constexpr std::size_t device_cells = 1 + write_status_count;
+
+private:
+  std::atomic<std::uint64_t> sequence{0};
+  std::vector<std::atomic<std::uint64_t>> cells;
+};
+}; // namespace erelic
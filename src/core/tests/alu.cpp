@@ -0,0 +1,93 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "alu.hpp"
+
+using namespace erelic;
+
+namespace {
+constexpr auto to_bcd(unsigned v) -> std::byte { return static_cast<std::byte>(((v / 10) << 4U) | (v % 10)); }
+
+auto result(unsigned value, std::uint8_t flags) -> alu_result {
+  return {.value = static_cast<std::byte>(value), .flags = flags};
+}
+}; // namespace
+
+TEST(alu, binary_adc_and_sbc_match_arithmetic) {
+  for (auto c = 0; c < 2; ++c) {
+    for (auto a = 0; a < 0x100; ++a) {
+      for (auto b = 0; b < 0x100; ++b) {
+        const auto sa = static_cast<int>(static_cast<std::int8_t>(a));
+        const auto sb = static_cast<int>(static_cast<std::int8_t>(b));
+        const auto sum = adc(std::byte(a), std::byte(b), c != 0, false);
+        EXPECT_EQ(std::to_integer<int>(sum.value), (a + b + c) & 0xFF);
+        EXPECT_EQ((sum.flags & flag_c) != 0, a + b + c > 0xFF);
+        EXPECT_EQ((sum.flags & flag_v) != 0, sa + sb + c < -128 || sa + sb + c > 127);
+
+        const auto difference = sbc(std::byte(a), std::byte(b), c != 0, false);
+        EXPECT_EQ(std::to_integer<int>(difference.value), (a - b - (1 - c)) & 0xFF);
+        EXPECT_EQ((difference.flags & flag_c) != 0, a - b - (1 - c) >= 0);
+        EXPECT_EQ((difference.flags & flag_v) != 0, sa - sb - (1 - c) < -128 || sa - sb - (1 - c) > 127);
+        EXPECT_EQ((difference.flags & flag_z) != 0, difference.value == std::byte{0x00});
+        EXPECT_EQ(difference.flags & flag_n, std::to_integer<int>(difference.value) & flag_n);
+      }
+    }
+  }
+}
+
+TEST(alu, decimal_results_of_valid_bcd) {
+  for (auto c = 0U; c < 2; ++c) {
+    for (auto a = 0U; a < 100; ++a) {
+      for (auto b = 0U; b < 100; ++b) {
+        const auto sum = adc(to_bcd(a), to_bcd(b), c != 0, true);
+        EXPECT_EQ(sum.value, to_bcd((a + b + c) % 100)) << a << "+" << b << "+" << c;
+        EXPECT_EQ((sum.flags & flag_c) != 0, a + b + c >= 100);
+
+        const auto difference = sbc(to_bcd(a), to_bcd(b), c != 0, true);
+        EXPECT_EQ(difference.value, to_bcd((a + 200 - b - (1 - c)) % 100)) << a << "-" << b << "-" << 1 - c;
+        EXPECT_EQ((difference.flags & flag_c) != 0, a + c >= b + 1);
+      }
+    }
+  }
+}
+
+TEST(alu, decimal_flags_follow_nmos) {
+  // Z from the binary sum $9A, N from the intermediate $A0.
+  EXPECT_EQ(adc(std::byte{0x99}, std::byte{0x01}, false, true), result(0x00, flag_n | flag_c));
+  // The intermediate $80 overflows.
+  EXPECT_EQ(adc(std::byte{0x79}, std::byte{0x00}, true, true), result(0x80, flag_n | flag_v));
+  // Binary sum $00 sets Z although the result is $60.
+  EXPECT_EQ(adc(std::byte{0x80}, std::byte{0x80}, false, true), result(0x60, flag_v | flag_z | flag_c));
+  // SBC takes every flag from the binary difference $F1.
+  EXPECT_EQ(sbc(std::byte{0x12}, std::byte{0x21}, true, true), result(0x91, flag_n));
+  EXPECT_EQ(sbc(std::byte{0x00}, std::byte{0x01}, true, true), result(0x99, flag_n));
+}
+
+TEST(alu, arr) {
+  EXPECT_EQ(arr(std::byte{0xFF}, std::byte{0xFF}, false, false), result(0x7F, flag_c));
+  EXPECT_EQ(arr(std::byte{0xFF}, std::byte{0x40}, true, false), result(0xA0, flag_n | flag_v));
+  EXPECT_EQ(arr(std::byte{0x0F}, std::byte{0x01}, false, false), result(0x00, flag_z));
+  EXPECT_EQ(arr(std::byte{0xFF}, std::byte{0xFF}, false, true), result(0xD5, flag_c));
+  EXPECT_EQ(arr(std::byte{0x0F}, std::byte{0xFF}, false, true), result(0x0D, 0));
+}
+
+TEST(alu, compare) {
+  EXPECT_EQ(compare(std::byte{0x20}, std::byte{0x20}), result(0x00, flag_z | flag_c));
+  EXPECT_EQ(compare(std::byte{0x10}, std::byte{0x20}), result(0xF0, flag_n));
+  EXPECT_EQ(compare(std::byte{0x80}, std::byte{0x01}), result(0x7F, flag_c));
+}
+
+TEST(alu, shifts_and_rotates) {
+  EXPECT_EQ(asl(std::byte{0x80}), result(0x00, flag_z | flag_c));
+  EXPECT_EQ(asl(std::byte{0x41}), result(0x82, flag_n));
+  EXPECT_EQ(lsr(std::byte{0x01}), result(0x00, flag_z | flag_c));
+  EXPECT_EQ(rol(std::byte{0x80}, true), result(0x01, flag_c));
+  EXPECT_EQ(ror(std::byte{0x01}, true), result(0x80, flag_n | flag_c));
+  EXPECT_EQ(ror(std::byte{0x02}, false), result(0x01, 0));
+}
@@ -0,0 +1,66 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+
+using namespace erelic;
+
+namespace {
+struct ram_mock {
+  std::array<std::byte, 0x100> cells{};
+
+  [[nodiscard]] auto read(address /*unused*/, address r) const noexcept -> std::byte { return cells[r.raw]; }
+  [[nodiscard]] auto write(address /*unused*/, address r, std::byte v) noexcept -> write_status {
+    cells[r.raw] = v;
+    return write_status::WRITTEN;
+  }
+};
+
+struct relative_echo {
+  [[nodiscard]] static auto read(address /*unused*/, address r) noexcept -> std::byte {
+    return std::byte{static_cast<unsigned char>(r.raw)};
+  }
+  [[nodiscard]] static auto write(address /*unused*/, address /*unused*/, std::byte /*unused*/) noexcept
+    -> write_status {
+    return write_status::IGNORED;
+  }
+};
+
+static_assert(io_bus<bus>);
+}; // namespace
+
+TEST(bus, routes_to_mapped_device_with_relative_address) {
+  auto b = bus{};
+  b.map(address_range{address{0x0000}, address{0x00FF}}, device{ram_mock{}});
+  b.map(address_range{address{0x8000}, address{0x80FF}}, device{relative_echo{}});
+
+  EXPECT_EQ(b.write(address{0x0010}, std::byte{0x5A}), write_status::WRITTEN);
+  EXPECT_EQ(b.read(address{0x0010}), std::byte{0x5A});
+  EXPECT_EQ(b.read(address{0x8042}), std::byte{0x42});
+  EXPECT_EQ(b.write(address{0x8042}, std::byte{0x01}), write_status::IGNORED);
+}
+
+TEST(bus, unmapped_access) {
+  auto b = bus{};
+  b.map(address_range{address{0x0000}, address{0x00FF}}, device{ram_mock{}});
+
+  EXPECT_EQ(b.read(address{0x1234}), unmapped_read);
+  EXPECT_EQ(b.write(address{0x1234}, std::byte{0x01}), write_status::FAILED);
+}
+
+TEST(bus, rejects_overlapping_ranges) {
+  auto b = bus{};
+  b.map(address_range{address{0x1000}, address{0x1FFF}}, device{ram_mock{}});
+
+  EXPECT_THROW(b.map(address_range{address{0x1FFF}, address{0x2FFF}}, device{ram_mock{}}), std::invalid_argument);
+  EXPECT_NO_THROW(b.map(address_range{address{0x2000}, address{0x2FFF}}, device{ram_mock{}}));
+}
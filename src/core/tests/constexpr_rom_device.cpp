@@ -0,0 +1,47 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "constexpr_rom_device.hpp"
+#include "device.hpp"
+#include "idle_loop.hpp"
+#include "static_bus.hpp"
+#include "test_rom.hpp"
+
+using namespace erelic;
+
+namespace {
+using rom = constexpr_rom_device<embedded::test_rom>;
+using firmware_bus = static_bus<mapping<address_range{address{0xC000}, address{0xFFFF}}, rom>>;
+
+static_assert(io_device<rom>);
+static_assert(pollable_device<rom>);
+static_assert(sizeof(rom) == 1);
+static_assert(embedded::test_rom.size() == 8);
+
+// LDA #$01; STA $0200; JMP $C000
+static_assert(rom::read(address{0xC000}, address{0}) == std::byte{0xA9});
+static_assert(firmware_bus{}.read(address{0xC005}) == std::byte{0x4C});
+static_assert(firmware_bus{}.read(address{0xFFF8}) == std::byte{0xA9});
+}; // namespace
+
+TEST(constexpr_rom_device, reads_embedded_image) {
+  const auto dev = device{rom{}};
+  EXPECT_EQ(dev.read(address{0xC001}, address{1}), std::byte{0x01});
+  EXPECT_EQ(dev.read(address{0xC00F}, address{0x000F}), std::byte{0xC0});
+  EXPECT_EQ(dev.stable_until(address{0}, 10), std::numeric_limits<std::uint64_t>::max());
+}
+
+TEST(constexpr_rom_device, ignores_writes) {
+  auto b = firmware_bus{};
+  EXPECT_EQ(b.write(address{0xC000}, std::byte{0x00}), write_status::IGNORED);
+  EXPECT_EQ(b.read(address{0xC000}), std::byte{0xA9});
+}
@@ -0,0 +1,153 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "core_hooks.hpp"
+#include "coverage.hpp"
+#include "instruction.hpp"
+#include "micro_ops.hpp"
+#include "registers.hpp"
+#include "statistics.hpp"
+
+using namespace erelic;
+
+namespace {
+struct flat_bus {
+  std::vector<std::byte> memory = std::vector<std::byte>(address_space_size);
+
+  [[nodiscard]] auto read(address a) const noexcept -> std::byte { return memory[a.raw]; }
+  [[nodiscard]] auto write(address a, std::byte v) noexcept -> write_status {
+    memory[a.raw] = v;
+    return write_status::WRITTEN;
+  }
+};
+
+struct core_mock {
+  [[nodiscard]] auto execute(const instruction & /*unused*/, std::byte value, address /*unused*/) noexcept
+    -> std::byte {
+    return value;
+  }
+  [[nodiscard]] auto taken(const instruction & /*unused*/, std::byte /*unused*/) noexcept -> bool { return false; }
+};
+
+enum class event {
+  FTCH,
+  READ,
+  WRIT,
+  INTR,
+  RETR,
+};
+
+struct recording_hooks {
+  std::vector<std::pair<event, address_raw>> *log;
+
+  void on_fetch(address a, std::byte /*unused*/) noexcept { log->emplace_back(event::FTCH, a.raw); }
+  void on_read(address a, std::byte /*unused*/) noexcept { log->emplace_back(event::READ, a.raw); }
+  void on_write(address a, std::byte /*unused*/) noexcept { log->emplace_back(event::WRIT, a.raw); }
+  void on_interrupt(address a) noexcept { log->emplace_back(event::INTR, a.raw); }
+  void on_retire(address a, const instruction & /*unused*/, const registers & /*unused*/) noexcept {
+    log->emplace_back(event::RETR, a.raw);
+  }
+};
+
+static_assert(core_hooks<recording_hooks>);
+static_assert(core_hooks<coverage_hooks<pc_coverage>>);
+static_assert(core_hooks<coverage_hooks<edge_coverage>>);
+static_assert(core_hooks<counting_hooks>);
+static_assert(core_hooks<hooks_chain<no_hooks, counting_hooks>>);
+static_assert(sizeof(micro_engine<flat_bus, core_mock>) < sizeof(micro_engine<flat_bus, core_mock, counting_hooks>));
+
+// LDA #$00; STA $10; BRK to $0300.
+auto make_program() -> flat_bus {
+  auto b = flat_bus{};
+  for (const auto &[at, v] : {std::pair{0x0200, 0xA9}, {0x0201, 0x00}, {0x0202, 0x85}, {0x0203, 0x10},
+                              {0x0204, 0x00}, {0xFFFE, 0x00}, {0xFFFF, 0x03}}) {
+    b.memory[static_cast<std::size_t>(at)] = static_cast<std::byte>(v);
+  }
+  return b;
+}
+}; // namespace
+
+TEST(core_hooks, events_in_bus_order) {
+  auto b = make_program();
+  auto regs = registers{.pc = address{0x0200}};
+  auto core = core_mock{};
+  auto log = std::vector<std::pair<event, address_raw>>{};
+  auto engine = micro_engine{b, core, regs, instruction_set::NMOS, recording_hooks{&log}};
+
+  EXPECT_EQ(engine.step(), 2U);
+  const auto load = std::vector<std::pair<event, address_raw>>{
+    {event::READ, 0x0200},
+    {event::FTCH, 0x0200},
+    {event::READ, 0x0201},
+    {event::RETR, 0x0200},
+  };
+  EXPECT_EQ(log, load);
+
+  log.clear();
+  EXPECT_EQ(engine.step(), 3U);
+  EXPECT_EQ(log.back(), std::pair(event::RETR, address_raw{0x0202}));
+  EXPECT_EQ(log[log.size() - 2], std::pair(event::WRIT, address_raw{0x0010}));
+
+  log.clear();
+  EXPECT_EQ(engine.step(), 7U);
+  EXPECT_EQ(std::ranges::count(log, std::pair(event::INTR, address_raw{0xFFFE})), 1);
+  EXPECT_EQ(std::ranges::count(log, event::WRIT, &std::pair<event, address_raw>::first), 3);
+  EXPECT_EQ(regs.pc.raw, 0x0300);
+}
+
+TEST(core_hooks, counting_matches_engine) {
+  auto b = make_program();
+  auto regs = registers{.pc = address{0x0200}};
+  auto core = core_mock{};
+  auto counts = core_counts{};
+  auto engine = micro_engine{b, core, regs, instruction_set::NMOS, counting_hooks{counts}};
+
+  auto cycles = std::size_t{0};
+  for (auto i = 0; i < 3; ++i) {
+    cycles += engine.step();
+  }
+  EXPECT_EQ(counts, (core_counts{.cycles = cycles, .instructions = 3, .interrupts = 1}));
+}
+
+TEST(core_hooks, coverage_marks_fetched_opcodes) {
+  auto b = make_program();
+  auto regs = registers{.pc = address{0x0200}};
+  auto core = core_mock{};
+  auto coverage = pc_coverage{};
+  auto engine = micro_engine{b, core, regs, instruction_set::NMOS, coverage_hooks{coverage}};
+
+  (void)engine.step();
+  (void)engine.step();
+  EXPECT_TRUE(coverage.executed(address{0x0200}));
+  EXPECT_FALSE(coverage.executed(address{0x0201}));
+  EXPECT_TRUE(coverage.executed(address{0x0202}));
+  EXPECT_EQ(coverage.count(), 2U);
+}
+
+TEST(core_hooks, chain_runs_every_policy) {
+  auto b = make_program();
+  auto regs = registers{.pc = address{0x0200}};
+  auto core = core_mock{};
+  auto counts = core_counts{};
+  auto retired = std::vector<address_raw>{};
+  auto trace = trace_hooks{[&](address pc, const instruction & /*unused*/, const registers & /*unused*/) noexcept {
+    retired.push_back(pc.raw);
+  }};
+  auto engine = micro_engine{b, core, regs, instruction_set::NMOS, hooks_chain{counting_hooks{counts}, trace}};
+
+  (void)engine.step();
+  (void)engine.step();
+  EXPECT_EQ(retired, (std::vector<address_raw>{0x0200, 0x0202}));
+  EXPECT_EQ(counts.instructions, 2U);
+  EXPECT_EQ(counts.cycles, 5U);
+}
@@ -0,0 +1,126 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "address.hpp"
+#include "coroutine_device.hpp"
+#include "device.hpp"
+
+using namespace erelic;
+
+namespace {
+using timer_device = coroutine_device<3>;
+
+static_assert(io_device<timer_device>);
+
+// Register 0 starts a countdown of `value` ticks of 10 cycles, register 1 holds the remaining ticks and register 2
+// the cycle (low byte) the countdown expired at.
+auto timer_body(frame_pool & /*pool*/, cycle_scheduler &scheduler, timer_device &dev) -> device_task {
+  while (true) {
+    const auto start = co_await dev.next_write();
+    if (start.relative.raw != 0) {
+      continue;
+    }
+    for (auto ticks = std::to_integer<unsigned>(start.value); ticks > 0; --ticks) {
+      co_await scheduler.after(10);
+      dev.registers[1] = std::byte{static_cast<unsigned char>(ticks - 1)};
+    }
+    dev.registers[2] = std::byte{static_cast<unsigned char>(scheduler.now())};
+  }
+}
+
+struct blinker {
+  std::vector<std::uint64_t> toggles;
+
+  auto body(frame_pool & /*pool*/, cycle_scheduler &scheduler, std::uint64_t period, std::size_t count)
+    -> device_task {
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      co_await scheduler.after(period);
+      toggles.push_back(scheduler.now());
+    }
+  }
+};
+
+auto wait_body(frame_pool & /*pool*/, cycle_scheduler &scheduler, bool &scheduled) -> device_task {
+  scheduled = co_await scheduler.after(5);
+}
+}; // namespace
+
+TEST(coroutine_device, body_resumes_on_writes_and_deadlines) {
+  auto pool = frame_pool{512, 4};
+  auto scheduler = cycle_scheduler{4};
+  auto timer = std::make_shared<timer_device>();
+  auto dev = device{timer};
+  const auto task = timer_body(pool, scheduler, *timer);
+  EXPECT_EQ(pool.used(), 1);
+
+  scheduler.advance_to(5);
+  EXPECT_EQ(dev.write(address{0xDC00}, address{0}, std::byte{3}), write_status::WRITTEN);
+  EXPECT_EQ(scheduler.next_deadline(), std::optional<std::uint64_t>{15});
+
+  scheduler.advance_to(24);
+  EXPECT_EQ(dev.read(address{0xDC01}, address{1}), std::byte{2});
+  scheduler.advance_to(35);
+  EXPECT_EQ(dev.read(address{0xDC01}, address{1}), std::byte{0});
+  EXPECT_EQ(dev.read(address{0xDC02}, address{2}), std::byte{35});
+  EXPECT_FALSE(scheduler.next_deadline().has_value());
+  EXPECT_FALSE(task.done());
+}
+
+TEST(coroutine_device, scheduler_resumes_in_deadline_order) {
+  auto pool = frame_pool{512, 4};
+  auto scheduler = cycle_scheduler{4};
+  auto fast = blinker{};
+  auto slow = blinker{};
+  {
+    const auto fast_task = fast.body(pool, scheduler, 3, 7);
+    const auto slow_task = slow.body(pool, scheduler, 7, 3);
+    EXPECT_EQ(pool.used(), 2);
+
+    scheduler.advance_to(21);
+    EXPECT_EQ(scheduler.now(), 21);
+    EXPECT_TRUE(fast_task.done());
+    EXPECT_TRUE(slow_task.done());
+    EXPECT_FALSE(scheduler.next_deadline().has_value());
+  }
+  EXPECT_EQ(pool.used(), 0);
+  EXPECT_EQ(fast.toggles, (std::vector<std::uint64_t>{3, 6, 9, 12, 15, 18, 21}));
+  EXPECT_EQ(slow.toggles, (std::vector<std::uint64_t>{7, 14, 21}));
+}
+
+TEST(coroutine_device, pool_exhaustion_throws) {
+  auto pool = frame_pool{512, 1};
+  auto scheduler = cycle_scheduler{4};
+  auto b = blinker{};
+  const auto first = b.body(pool, scheduler, 1, 1);
+  EXPECT_THROW((void)b.body(pool, scheduler, 1, 1), std::bad_alloc);
+
+  auto tiny = frame_pool{8, 1};
+  EXPECT_THROW((void)b.body(tiny, scheduler, 1, 1), std::bad_alloc);
+
+  scheduler.advance_to(1);
+  EXPECT_TRUE(first.done());
+}
+
+TEST(coroutine_device, full_scheduler_resumes_at_once) {
+  auto pool = frame_pool{512, 2};
+  auto scheduler = cycle_scheduler{1};
+  auto first = false;
+  auto second = false;
+  const auto waiting = wait_body(pool, scheduler, first);
+  const auto rejected = wait_body(pool, scheduler, second);
+  EXPECT_TRUE(rejected.done());
+  EXPECT_FALSE(second);
+
+  scheduler.advance_to(5);
+  EXPECT_TRUE(waiting.done());
+  EXPECT_TRUE(first);
+}
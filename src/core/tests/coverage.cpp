@@ -0,0 +1,108 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "address.hpp"
+#include "coverage.hpp"
+
+using namespace erelic;
+
+TEST(coverage, pc_bitmap_marks_fetched_addresses) {
+  auto cov = pc_coverage{};
+  cov.mark(address{0x0000});
+  cov.mark(address{0xC003});
+  cov.mark(address{0xC003});
+  cov.mark(address{0xFFFF});
+
+  EXPECT_TRUE(cov.executed(address{0x0000}));
+  EXPECT_TRUE(cov.executed(address{0xC003}));
+  EXPECT_TRUE(cov.executed(address{0xFFFF}));
+  EXPECT_FALSE(cov.executed(address{0xC004}));
+  EXPECT_EQ(cov.count(), 3);
+
+  const auto raw = cov.raw();
+  EXPECT_EQ(raw.size(), 8192);
+  EXPECT_EQ(raw[0xC003 / 8], 1U << 3U);
+  EXPECT_EQ(raw[0x1FFF], 0x80);
+
+  cov.reset();
+  EXPECT_EQ(cov.count(), 0);
+  EXPECT_FALSE(cov.executed(address{0xC003}));
+}
+
+TEST(coverage, pc_bitmap_writes_to_external_memory) {
+  auto shared = std::vector<std::uint8_t>(pc_coverage::bitmap_size);
+  auto cov = pc_coverage{shared};
+  EXPECT_EQ(cov.raw().data(), shared.data());
+
+  cov.mark(address{0xC003});
+  cov.mark(address{0xFFFF});
+  EXPECT_EQ(shared[0xC003 / 8], 1U << 3U);
+  EXPECT_EQ(shared[0x1FFF], 0x80);
+  EXPECT_EQ(cov.count(), 2);
+
+  auto moved = std::move(cov);
+  moved.mark(address{0x0000});
+  EXPECT_EQ(shared[0], 1);
+
+  moved.reset();
+  EXPECT_TRUE(std::ranges::all_of(shared, [](std::uint8_t v) { return v == 0; }));
+}
+
+TEST(coverage, pc_bitmap_needs_one_bit_per_address) {
+  auto small = std::vector<std::uint8_t>(pc_coverage::bitmap_size - 1);
+  EXPECT_THROW(pc_coverage{small}, std::invalid_argument);
+  auto large = std::vector<std::uint8_t>(pc_coverage::bitmap_size + 1);
+  EXPECT_THROW(pc_coverage{large}, std::invalid_argument);
+}
+
+TEST(coverage, edge_map_distinguishes_direction) {
+  auto forward = edge_coverage{};
+  forward.mark(address{0xC000});
+  forward.mark(address{0xC010});
+
+  auto backward = edge_coverage{};
+  backward.mark(address{0xC010});
+  backward.mark(address{0xC000});
+
+  const auto hits = [](const edge_coverage &cov) {
+    return std::accumulate(cov.raw().begin(), cov.raw().end(), 0U);
+  };
+  EXPECT_EQ(hits(forward), 2);
+  EXPECT_EQ(hits(backward), 2);
+  EXPECT_FALSE(std::ranges::equal(forward.raw(), backward.raw()));
+}
+
+TEST(coverage, edge_map_writes_to_external_memory) {
+  auto shared = std::array<std::uint8_t, 256>{};
+  auto cov = edge_coverage{shared};
+  EXPECT_EQ(cov.raw().data(), shared.data());
+
+  for (auto i = 0; i < 3; ++i) {
+    cov.restart();
+    cov.mark(address{0x0600});
+    cov.mark(address{0x0602});
+  }
+  EXPECT_EQ(*std::ranges::max_element(shared), 3);
+
+  cov.reset();
+  EXPECT_TRUE(std::ranges::all_of(shared, [](std::uint8_t v) { return v == 0; }));
+}
+
+TEST(coverage, edge_map_size_must_be_power_of_two) {
+  EXPECT_THROW(edge_coverage{std::size_t{0}}, std::invalid_argument);
+  EXPECT_THROW(edge_coverage{std::size_t{1000}}, std::invalid_argument);
+  auto odd = std::array<std::uint8_t, 100>{};
+  EXPECT_THROW(edge_coverage{odd}, std::invalid_argument);
+}
@@ -0,0 +1,146 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "address.hpp"
+#include "cycle_analyzer.hpp"
+#include "instruction.hpp"
+
+using namespace erelic;
+
+namespace {
+constexpr auto origin = address_raw{0xC000};
+
+struct rom_image {
+  std::vector<std::byte> bytes = std::vector<std::byte>(0x200, std::byte{0xEA});
+
+  void put(address_raw at, std::initializer_list<std::uint8_t> code) {
+    for (const auto b : code) {
+      bytes[at++ - origin] = std::byte{b};
+    }
+  }
+};
+}; // namespace
+
+TEST(cycle_analyzer, straight_line) {
+  auto rom = rom_image{};
+  rom.put(0xC000, {0xA9, 0x00, 0x8D, 0x20, 0xD0, 0x60}); // LDA #$00; STA $D020; RTS
+  auto analyzer = cycle_analyzer{rom.bytes, address{origin}, instruction_set::NMOS};
+
+  const auto report = analyzer.analyze(address{0xC000});
+  EXPECT_EQ(report.best, 12U);
+  EXPECT_EQ(report.worst, 12U);
+  EXPECT_EQ(report.instructions, 3U);
+  EXPECT_TRUE(report.loops.empty());
+  EXPECT_TRUE(report.unresolved.empty());
+}
+
+TEST(cycle_analyzer, branch_paths) {
+  auto rom = rom_image{};
+  rom.put(0xC000, {0xA5, 0x10, 0xF0, 0x02, 0xA2, 0x01, 0x60}); // LDA $10; BEQ +2; LDX #$01; RTS
+  auto analyzer = cycle_analyzer{rom.bytes, address{origin}, instruction_set::NMOS};
+
+  const auto report = analyzer.analyze(address{0xC000});
+  EXPECT_EQ(report.best, 12U);
+  EXPECT_EQ(report.worst, 13U);
+}
+
+TEST(cycle_analyzer, branch_across_page) {
+  auto rom = rom_image{};
+  rom.put(0xC0FC, {0xF0, 0x02, 0xEA, 0xEA, 0x60}); // BEQ $C100; NOP; NOP; RTS
+  auto analyzer = cycle_analyzer{rom.bytes, address{origin}, instruction_set::NMOS};
+
+  const auto report = analyzer.analyze(address{0xC0FC});
+  EXPECT_EQ(report.best, 10U);
+  EXPECT_EQ(report.worst, 12U);
+}
+
+TEST(cycle_analyzer, indexed_base_at_page_start_never_crosses) {
+  auto rom = rom_image{};
+  rom.put(0xC000, {0xBD, 0x00, 0xC1, 0xBD, 0x01, 0xC1, 0x60}); // LDA $C100,X; LDA $C101,X; RTS
+  auto analyzer = cycle_analyzer{rom.bytes, address{origin}, instruction_set::NMOS};
+
+  const auto report = analyzer.analyze(address{0xC000});
+  EXPECT_EQ(report.best, 14U);
+  EXPECT_EQ(report.worst, 15U);
+}
+
+TEST(cycle_analyzer, long_straight_line) {
+  // A ROM of NOPs up to an RTS at $FFFF, deeper than a recursive walk of the path could go on a small stack.
+  auto rom = rom_image{};
+  rom.bytes.resize(0x4000, std::byte{0xEA});
+  rom.bytes.back() = std::byte{0x60};
+  auto analyzer = cycle_analyzer{rom.bytes, address{origin}, instruction_set::NMOS};
+
+  const auto report = analyzer.analyze(address{0xC000});
+  EXPECT_EQ(report.best, 0x3FFFU * 2 + 6);
+  EXPECT_EQ(report.worst, 0x3FFFU * 2 + 6);
+  EXPECT_EQ(report.instructions, 0x4000U);
+}
+
+TEST(cycle_analyzer, loop_is_unbounded) {
+  auto rom = rom_image{};
+  rom.put(0xC000, {0xA2, 0x08, 0xCA, 0xD0, 0xFD, 0x60}); // LDX #$08; DEX; BNE -3; RTS
+  auto analyzer = cycle_analyzer{rom.bytes, address{origin}, instruction_set::NMOS};
+
+  const auto report = analyzer.analyze(address{0xC000});
+  EXPECT_EQ(report.best, 12U);
+  EXPECT_FALSE(report.worst);
+  EXPECT_EQ(report.loops, std::vector{address{0xC003}});
+
+  auto os = std::ostringstream{};
+  os << report;
+  EXPECT_EQ(os.str(), "ADDR(0xC000): 12..unbounded cycles, 4 instructions\n  loop at ADDR(0xC003)");
+}
+
+TEST(cycle_analyzer, subroutines) {
+  auto rom = rom_image{};
+  rom.put(0xC000, {0x20, 0x10, 0xC0, 0x60}); // JSR $C010; RTS
+  rom.put(0xC010, {0xEA, 0x60});             // NOP; RTS
+  rom.put(0xC020, {0x20, 0x20, 0xC0, 0x60}); // JSR $C020; RTS
+  auto analyzer = cycle_analyzer{rom.bytes, address{origin}, instruction_set::NMOS};
+
+  const auto reports = analyzer.analyze(std::vector{address{0xC000}, address{0xC010}, address{0xC020}});
+  ASSERT_EQ(reports.size(), 3U);
+  EXPECT_EQ(reports[0].worst, 20U);
+  EXPECT_EQ(reports[1].worst, 8U);
+  EXPECT_FALSE(reports[2].worst);
+  EXPECT_EQ(reports[2].loops, std::vector{address{0xC020}});
+}
+
+TEST(cycle_analyzer, indirect_jumps) {
+  auto rom = rom_image{};
+  rom.put(0xC000, {0x6C, 0x00, 0x03}); // JMP ($0300)
+  rom.put(0xC010, {0x6C, 0xFF, 0xC0}); // JMP ($C0FF)
+  rom.put(0xC0FF, {0x40});             // low byte, high byte from $C000 on NMOS and $C100 on CMOS
+  rom.put(0xC100, {0xC1});
+  rom.put(0xC140, {0x60});             // RTS
+  auto nmos = cycle_analyzer{rom.bytes, address{origin}, instruction_set::NMOS};
+  auto cmos = cycle_analyzer{rom.bytes, address{origin}, instruction_set::CMOS};
+
+  const auto unresolved = nmos.analyze(address{0xC000});
+  EXPECT_EQ(unresolved.worst, 5U);
+  EXPECT_EQ(unresolved.unresolved, std::vector{address{0xC000}});
+
+  // $6C at $C000 makes the NMOS target $6C40.
+  const auto buggy = nmos.analyze(address{0xC010});
+  EXPECT_EQ(buggy.unresolved, std::vector{address{0xC010}});
+
+  const auto fixed = cmos.analyze(address{0xC010});
+  EXPECT_EQ(fixed.worst, 6U + 6U);
+  EXPECT_TRUE(fixed.unresolved.empty());
+}
+
+TEST(cycle_analyzer, rejects_code_past_address_space) {
+  const auto code = std::vector<std::byte>(2);
+  EXPECT_THROW((cycle_analyzer{code, address{0xFFFF}, instruction_set::NMOS}), std::invalid_argument);
+}
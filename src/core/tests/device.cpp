@@ -9,6 +9,8 @@
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <numeric>
 #include <random>
 #include <string>
@@ -53,7 +55,7 @@ struct move_only_device {
   }
 };
 
-static_assert(std::constructible_from<device, move_only_device>);
+static_assert(std::constructible_from<device, std::shared_ptr<move_only_device>>);
 
 template <std::size_t N>
 struct buffer_device {
@@ -66,6 +68,22 @@ struct buffer_device {
     return write_status::IGNORED;
   }
 };
+
+struct latch_device {
+  std::byte value{0};
+
+  [[nodiscard]] auto read(address /*unused*/, address /*unused*/) const noexcept -> std::byte { return value; }
+  [[nodiscard]] auto write(address /*unused*/, address /*unused*/, std::byte v) noexcept -> write_status {
+    value = v;
+    return write_status::WRITTEN;
+  }
+};
+
+static_assert(io_device<device>);
+static_assert(device::stores_inline<io_device_mock>);
+static_assert(device::stores_inline<latch_device>);
+static_assert(!device::stores_inline<buffer_device<64>>);
+static_assert(!device::stores_inline<move_only_device>);
 }; // namespace
 
 TEST(device, read_returns_value_from_impl) {
@@ -130,13 +148,71 @@ TEST(device, write_is_noexcept) {
   EXPECT_NO_THROW((void)dev.write(address{0}, address{0}, std::byte{0xFF}));
 }
 
-TEST(device, supports_move_only_impl) {
-  auto mod = move_only_device{};
-  auto dev = device{std::move(mod)};
+TEST(device, shares_move_only_impl_explicitly) {
+  auto dev = device{std::make_shared<move_only_device>()};
   EXPECT_EQ(dev.read(address{0}, address{0}), std::byte{0xAA});
   EXPECT_EQ(dev.write(address{0}, address{0}, std::byte{0}), write_status::FAILED);
 }
 
+TEST(device, copy_owns_independent_state) {
+  auto dev1 = device{latch_device{}};
+  EXPECT_EQ(dev1.write(address{0}, address{0}, std::byte{0x11}), write_status::WRITTEN);
+
+  auto dev2 = dev1;
+  EXPECT_EQ(dev2.write(address{0}, address{0}, std::byte{0x22}), write_status::WRITTEN);
+
+  EXPECT_EQ(dev1.read(address{0}, address{0}), std::byte{0x11});
+  EXPECT_EQ(dev2.read(address{0}, address{0}), std::byte{0x22});
+}
+
+TEST(device, copy_owns_independent_heap_state) {
+  auto dev1 = device{buffer_device<64>{{}}};
+  auto dev2 = dev1;
+  dev1 = device{latch_device{std::byte{0x5A}}};
+
+  EXPECT_EQ(dev1.read(address{0}, address{0}), std::byte{0x5A});
+  EXPECT_EQ(dev2.read(address{0}, address{0}), std::byte{0x00});
+}
+
+TEST(device, copy_of_moved_from_device_is_moved_from) {
+  auto dev1 = device{buffer_device<64>{{}}};
+  auto dev2 = device{std::move(dev1)};
+  // NOLINTNEXTLINE(bugprone-use-after-move, hicpp-invalid-access-moved)
+  auto dev3 = dev1;
+  dev3 = dev2;
+  EXPECT_EQ(dev3.read(address{0}, address{0}), std::byte{0x00});
+}
+
+TEST(device, shared_ptr_shares_state) {
+  auto impl = std::make_shared<latch_device>();
+  auto dev1 = device{impl};
+  auto dev2 = dev1;
+
+  EXPECT_EQ(dev2.write(address{0}, address{0}, std::byte{0x33}), write_status::WRITTEN);
+  EXPECT_EQ(dev1.read(address{0}, address{0}), std::byte{0x33});
+  EXPECT_EQ(impl->value, std::byte{0x33});
+}
+
+TEST(device, reference_borrows_state) {
+  auto impl = latch_device{};
+  auto dev1 = device{std::ref(impl)};
+  auto dev2 = dev1;
+
+  EXPECT_EQ(dev2.write(address{0}, address{0}, std::byte{0x77}), write_status::WRITTEN);
+  EXPECT_EQ(dev1.read(address{0}, address{0}), std::byte{0x77});
+  EXPECT_EQ(impl.value, std::byte{0x77});
+}
+
+TEST(device, move_preserves_behavior) {
+  auto dev1 = device{latch_device{std::byte{0x44}}};
+  auto dev2 = device{std::move(dev1)};
+  EXPECT_EQ(dev2.read(address{0}, address{0}), std::byte{0x44});
+
+  auto dev3 = device{io_device_mock{}};
+  dev3 = std::move(dev2);
+  EXPECT_EQ(dev3.read(address{0}, address{0}), std::byte{0x44});
+}
+
 namespace {
 consteval auto make_max_memory_buf() {
   constexpr auto max_addressable_memory_size = 0x1'0000;
@@ -0,0 +1,107 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+#include "direct_pages.hpp"
+#include "static_bus.hpp"
+
+using namespace erelic;
+
+namespace {
+struct ram_mock {
+  std::array<std::byte, 0x800> cells{};
+
+  [[nodiscard]] auto read(address /*unused*/, address r) const noexcept -> std::byte { return cells[r.raw]; }
+  [[nodiscard]] auto write(address /*unused*/, address r, std::byte v) noexcept -> write_status {
+    cells[r.raw] = v;
+    return write_status::WRITTEN;
+  }
+  [[nodiscard]] auto memory() noexcept -> std::span<std::byte> { return cells; }
+};
+
+// Same contents as RAM but dispatched, e.g. a mirror or a watched range.
+struct io_mock {
+  std::array<std::byte, 0x100> cells{};
+
+  [[nodiscard]] auto read(address /*unused*/, address r) const noexcept -> std::byte { return cells[r.raw]; }
+  [[nodiscard]] auto write(address /*unused*/, address r, std::byte v) noexcept -> write_status {
+    cells[r.raw] = v;
+    return write_status::WRITTEN;
+  }
+};
+
+static_assert(memory_device<ram_mock>);
+static_assert(!memory_device<io_mock>);
+static_assert(page_binding_bus<bus>);
+}; // namespace
+
+TEST(direct_pages, binds_ram_backed_pages) {
+  auto b = bus{};
+  b.map(address_range{address{0x0000}, address{0x07FF}}, device{ram_mock{}});
+  auto pages = direct_pages{b};
+  ASSERT_TRUE(pages.zero_page_direct());
+  ASSERT_TRUE(pages.stack_direct());
+
+  EXPECT_EQ(pages.write_zero_page(0x10, std::byte{0x34}), write_status::WRITTEN);
+  EXPECT_EQ(pages.write_zero_page(0x11, std::byte{0x12}), write_status::WRITTEN);
+  EXPECT_EQ(b.read(address{0x0010}), std::byte{0x34});
+  EXPECT_EQ(pages.read_zero_page_word(0x10), 0x1234);
+
+  EXPECT_EQ(b.write(address{0x00FF}, std::byte{0xCD}), write_status::WRITTEN);
+  EXPECT_EQ(b.write(address{0x0000}, std::byte{0xAB}), write_status::WRITTEN);
+  EXPECT_EQ(pages.read_zero_page_word(0xFF), 0xABCD);
+
+  EXPECT_EQ(pages.write_stack(0xFD, std::byte{0x77}), write_status::WRITTEN);
+  EXPECT_EQ(b.read(address{0x01FD}), std::byte{0x77});
+  EXPECT_EQ(pages.read_stack(0xFD), std::byte{0x77});
+}
+
+TEST(direct_pages, bound_pages_stay_dirty) {
+  auto b = bus{};
+  b.map(address_range{address{0x0000}, address{0x07FF}}, device{ram_mock{}});
+  const auto pages = direct_pages{b};
+  ASSERT_TRUE(pages.zero_page_direct());
+
+  b.clear_dirty_pages();
+  EXPECT_TRUE(b.dirty_pages().test(zero_page));
+  EXPECT_TRUE(b.dirty_pages().test(stack_page));
+  EXPECT_EQ(b.dirty_pages().count(), 2);
+}
+
+TEST(direct_pages, falls_back_to_bus_dispatch) {
+  auto b = bus{};
+  b.map(address_range{address{0x0000}, address{0x00FF}}, device{io_mock{}});
+  b.map(address_range{address{0x0100}, address{0x017F}}, device{ram_mock{}});
+  b.map(address_range{address{0x0180}, address{0x01FF}}, device{ram_mock{}});
+  auto pages = direct_pages{b};
+  EXPECT_FALSE(pages.zero_page_direct());
+  EXPECT_FALSE(pages.stack_direct());
+
+  EXPECT_EQ(pages.write_zero_page(0x20, std::byte{0x42}), write_status::WRITTEN);
+  EXPECT_EQ(b.read(address{0x0020}), std::byte{0x42});
+  EXPECT_EQ(pages.write_stack(0xF0, std::byte{0x99}), write_status::WRITTEN);
+  EXPECT_EQ(pages.read_stack(0xF0), std::byte{0x99});
+  EXPECT_EQ(b.read(address{0x01F0}), std::byte{0x99});
+}
+
+TEST(direct_pages, static_bus_binds_pages) {
+  using ram_mapping = mapping<address_range{address{0x0000}, address{0x07FF}}, ram_mock>;
+  using io_mapping = mapping<address_range{address{0xD000}, address{0xD0FF}}, io_mock>;
+  auto b = static_bus<ram_mapping, io_mapping>{};
+  EXPECT_TRUE(b.bind_page(0xD0).empty());
+
+  auto pages = direct_pages{b};
+  ASSERT_TRUE(pages.zero_page_direct());
+  EXPECT_EQ(pages.write_zero_page(0x80, std::byte{0x01}), write_status::WRITTEN);
+  EXPECT_EQ(b.read(address{0x0080}), std::byte{0x01});
+}
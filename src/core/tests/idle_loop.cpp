@@ -0,0 +1,164 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+#include "idle_loop.hpp"
+#include "instruction.hpp"
+
+using namespace erelic;
+
+namespace {
+struct ram_mock {
+  std::vector<std::byte> cells = std::vector<std::byte>(0x1000);
+
+  [[nodiscard]] auto read(address /*unused*/, address r) const noexcept -> std::byte { return cells[r.raw]; }
+  [[nodiscard]] auto write(address /*unused*/, address r, std::byte v) noexcept -> write_status {
+    cells[r.raw] = v;
+    return write_status::WRITTEN;
+  }
+  // Only the CPU writes RAM, and an idle loop does not.
+  [[nodiscard]] static auto stable_until(address /*unused*/, std::uint64_t /*unused*/) noexcept -> std::uint64_t {
+    return std::numeric_limits<std::uint64_t>::max();
+  }
+};
+
+// Status register that flips at a known cycle, like a raster or timer flag.
+struct status_mock {
+  std::uint64_t changes_at = 0;
+
+  [[nodiscard]] static auto read(address /*unused*/, address /*unused*/) noexcept -> std::byte { return std::byte{0}; }
+  [[nodiscard]] static auto write(address /*unused*/, address /*unused*/, std::byte /*unused*/) noexcept
+    -> write_status {
+    return write_status::IGNORED;
+  }
+  [[nodiscard]] auto stable_until(address /*unused*/, std::uint64_t now) const noexcept -> std::uint64_t {
+    return std::max(now, changes_at);
+  }
+};
+
+// Acknowledges on read, so it is not pollable.
+struct fifo_mock {
+  [[nodiscard]] static auto read(address /*unused*/, address /*unused*/) noexcept -> std::byte { return std::byte{0}; }
+  [[nodiscard]] static auto write(address /*unused*/, address /*unused*/, std::byte /*unused*/) noexcept
+    -> write_status {
+    return write_status::IGNORED;
+  }
+};
+
+static_assert(pollable_device<ram_mock>);
+static_assert(pollable_device<status_mock>);
+static_assert(!pollable_device<fifo_mock>);
+static_assert(pollable_bus<bus>);
+
+auto make_bus(std::uint64_t status_changes_at) -> bus {
+  auto b = bus{};
+  b.map(address_range{address{0x0000}, address{0x0FFF}}, device{ram_mock{}});
+  b.map(address_range{address{0xD000}, address{0xD0FF}}, device{status_mock{status_changes_at}});
+  b.map(address_range{address{0xD100}, address{0xD1FF}}, device{fifo_mock{}});
+  return b;
+}
+
+void load(bus &b, address_raw origin, std::initializer_list<unsigned char> code) {
+  for (const auto byte : code) {
+    (void)b.write(address{origin++}, std::byte{byte});
+  }
+}
+
+const auto &nmos = instruction_table_for(instruction_set::NMOS);
+const auto &cmos = instruction_table_for(instruction_set::CMOS);
+}; // namespace
+
+TEST(idle_loop, detects_polling_loop) {
+  auto b = make_bus(0);
+  load(b, 0x0600, {0xAD, 0x00, 0xD0, 0xF0, 0xFB}); // LDA $D000; BEQ $0600
+
+  const auto loop = find_idle_loop(b, nmos, address{0x0603});
+  ASSERT_TRUE(loop.has_value());
+  EXPECT_EQ(loop->start, address{0x0600});
+  EXPECT_EQ(loop->cycles_per_iteration, 4 + 3);
+  ASSERT_EQ(loop->polled_count, 1);
+  EXPECT_EQ(loop->polled[0], 0xD000);
+}
+
+TEST(idle_loop, counts_exit_branches_and_page_crossing) {
+  auto b = make_bus(0);
+  // $06FA: LDA $D000; AND #$80; BNE $0720; JMP $06FA
+  load(b, 0x06FA, {0xAD, 0x00, 0xD0, 0x29, 0x80, 0xD0, 0x19, 0x4C, 0xFA, 0x06});
+  const auto jumped = find_idle_loop(b, nmos, address{0x0701});
+  ASSERT_TRUE(jumped.has_value());
+  EXPECT_EQ(jumped->cycles_per_iteration, 4 + 2 + 2 + 3);
+
+  // $07FC: BIT $D000; BPL $07FC, the branch crosses back into the previous page.
+  load(b, 0x07FC, {0x2C, 0x00, 0xD0, 0x10, 0xFB});
+  const auto crossing = find_idle_loop(b, nmos, address{0x07FF});
+  ASSERT_TRUE(crossing.has_value());
+  EXPECT_EQ(crossing->cycles_per_iteration, 4 + 4);
+
+  // $0080: BBR7 $10, $0080 (65C02)
+  load(b, 0x0080, {0x7F, 0x10, 0xFD});
+  const auto bit_branch = find_idle_loop(b, cmos, address{0x0080});
+  ASSERT_TRUE(bit_branch.has_value());
+  EXPECT_EQ(bit_branch->polled[0], 0x0010);
+}
+
+TEST(idle_loop, rejects_loops_with_side_effects) {
+  auto b = make_bus(0);
+  load(b, 0x0600, {0xCA, 0xD0, 0xFD});                         // DEX; BNE $0600
+  load(b, 0x0610, {0xAD, 0x00, 0xD0, 0x8D, 0x00, 0x02, 0xF0, 0xF8}); // LDA $D000; STA $0200; BEQ $0610
+  load(b, 0x0620, {0xB5, 0x10, 0xF0, 0xFC});                   // LDA $10,X; BEQ $0620
+  load(b, 0x0630, {0xAD, 0x00, 0xD0, 0xF0, 0x00, 0xD0, 0xF9}); // LDA $D000; BEQ +0; BNE $0630
+  load(b, 0x0640, {0xAD, 0x00, 0xD0, 0xF0, 0x02});             // LDA $D000; BEQ $0647 (forward)
+
+  EXPECT_FALSE(find_idle_loop(b, nmos, address{0x0601}).has_value());
+  EXPECT_FALSE(find_idle_loop(b, nmos, address{0x0616}).has_value());
+  EXPECT_FALSE(find_idle_loop(b, nmos, address{0x0622}).has_value());
+  EXPECT_FALSE(find_idle_loop(b, nmos, address{0x0635}).has_value());
+  EXPECT_FALSE(find_idle_loop(b, nmos, address{0x0643}).has_value());
+}
+
+TEST(idle_loop, skips_whole_iterations_until_change) {
+  auto b = make_bus(1000);
+  load(b, 0x0600, {0xAD, 0x00, 0xD0, 0xF0, 0xFB}); // LDA $D000; BEQ $0600
+  auto skipper = idle_skipper{nmos};
+
+  EXPECT_EQ(skipper.on_backward_branch(b, address{0x0603}, 100, 5000), 0);
+  EXPECT_EQ(skipper.on_backward_branch(b, address{0x0603}, 107, 5000), (1000 - 107) / 7 * 7);
+  const auto resumed = 107 + (1000 - 107) / 7 * 7;
+  EXPECT_EQ(skipper.on_backward_branch(b, address{0x0603}, resumed + 7, 5000), 0);
+}
+
+TEST(idle_loop, skip_stops_before_next_event) {
+  auto b = make_bus(std::numeric_limits<std::uint64_t>::max());
+  load(b, 0x0600, {0xAD, 0x00, 0xD0, 0xF0, 0xFB});
+  auto skipper = idle_skipper{nmos};
+
+  EXPECT_EQ(skipper.on_backward_branch(b, address{0x0603}, 0, 100), 0);
+  EXPECT_EQ(skipper.on_backward_branch(b, address{0x0603}, 7, 100), 91);
+  EXPECT_EQ(skipper.on_backward_branch(b, address{0x0603}, 105, 200), 91);
+}
+
+TEST(idle_loop, does_not_skip_reads_with_side_effects_or_partial_iterations) {
+  auto b = make_bus(std::numeric_limits<std::uint64_t>::max());
+  load(b, 0x0600, {0xAD, 0x00, 0xD1, 0xF0, 0xFB}); // LDA $D100; BEQ $0600
+  load(b, 0x0610, {0xAD, 0x00, 0xD0, 0xF0, 0xFB}); // LDA $D000; BEQ $0610
+  auto skipper = idle_skipper{nmos};
+
+  EXPECT_EQ(skipper.on_backward_branch(b, address{0x0603}, 0, 1000), 0);
+  EXPECT_EQ(skipper.on_backward_branch(b, address{0x0603}, 7, 1000), 0);
+
+  EXPECT_EQ(skipper.on_backward_branch(b, address{0x0613}, 10, 1000), 0);
+  EXPECT_EQ(skipper.on_backward_branch(b, address{0x0613}, 30, 1000), 0);
+  EXPECT_NE(skipper.on_backward_branch(b, address{0x0613}, 37, 1000), 0);
+}
@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <ranges>
 #include <tuple>
+#include <utility>
 
 #include "instruction.hpp"
 
@@ -280,6 +281,121 @@ constexpr auto nmos = std::array{
   instruction{ .opcode=std::byte{0x97}, .op=mnemonic::SAX, .mode=address_mode::ZPAY, .length=2, .cycles=4, .set=instruction_set::NMOS },
   // clang-format on
 };
+
+constexpr auto cmos = std::array{
+  // clang-format off
+  instruction{ .opcode=std::byte{0x72}, .op=mnemonic::ADC, .mode=address_mode::ZPIN, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x32}, .op=mnemonic::AND, .mode=address_mode::ZPIN, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xD2}, .op=mnemonic::CMP, .mode=address_mode::ZPIN, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x52}, .op=mnemonic::EOR, .mode=address_mode::ZPIN, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xB2}, .op=mnemonic::LDA, .mode=address_mode::ZPIN, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x12}, .op=mnemonic::ORA, .mode=address_mode::ZPIN, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xF2}, .op=mnemonic::SBC, .mode=address_mode::ZPIN, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x92}, .op=mnemonic::STA, .mode=address_mode::ZPIN, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x89}, .op=mnemonic::BIT, .mode=address_mode::IMME, .length=2, .cycles=2, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x34}, .op=mnemonic::BIT, .mode=address_mode::ZPAX, .length=2, .cycles=4, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x3C}, .op=mnemonic::BIT, .mode=address_mode::ABSX, .length=3, .cycles=4, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x80}, .op=mnemonic::BRA, .mode=address_mode::RELA, .length=2, .cycles=3, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x1A}, .op=mnemonic::INC, .mode=address_mode::ACCU, .length=1, .cycles=2, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x3A}, .op=mnemonic::DEC, .mode=address_mode::ACCU, .length=1, .cycles=2, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x6C}, .op=mnemonic::JMP, .mode=address_mode::INDR, .length=3, .cycles=6, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x7C}, .op=mnemonic::JMP, .mode=address_mode::INAX, .length=3, .cycles=6, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x1E}, .op=mnemonic::ASL, .mode=address_mode::ABSX, .length=3, .cycles=6, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x5E}, .op=mnemonic::LSR, .mode=address_mode::ABSX, .length=3, .cycles=6, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x3E}, .op=mnemonic::ROL, .mode=address_mode::ABSX, .length=3, .cycles=6, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x7E}, .op=mnemonic::ROR, .mode=address_mode::ABSX, .length=3, .cycles=6, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xDA}, .op=mnemonic::PHX, .mode=address_mode::IMPL, .length=1, .cycles=3, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x5A}, .op=mnemonic::PHY, .mode=address_mode::IMPL, .length=1, .cycles=3, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xFA}, .op=mnemonic::PLX, .mode=address_mode::IMPL, .length=1, .cycles=4, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x7A}, .op=mnemonic::PLY, .mode=address_mode::IMPL, .length=1, .cycles=4, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x64}, .op=mnemonic::STZ, .mode=address_mode::ZPAG, .length=2, .cycles=3, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x74}, .op=mnemonic::STZ, .mode=address_mode::ZPAX, .length=2, .cycles=4, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x9C}, .op=mnemonic::STZ, .mode=address_mode::ABSL, .length=3, .cycles=4, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x9E}, .op=mnemonic::STZ, .mode=address_mode::ABSX, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x14}, .op=mnemonic::TRB, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x1C}, .op=mnemonic::TRB, .mode=address_mode::ABSL, .length=3, .cycles=6, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x04}, .op=mnemonic::TSB, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x0C}, .op=mnemonic::TSB, .mode=address_mode::ABSL, .length=3, .cycles=6, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xCB}, .op=mnemonic::WAI, .mode=address_mode::IMPL, .length=1, .cycles=3, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xDB}, .op=mnemonic::STP, .mode=address_mode::IMPL, .length=1, .cycles=3, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x07}, .op=mnemonic::RMB0, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x17}, .op=mnemonic::RMB1, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x27}, .op=mnemonic::RMB2, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x37}, .op=mnemonic::RMB3, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x47}, .op=mnemonic::RMB4, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x57}, .op=mnemonic::RMB5, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x67}, .op=mnemonic::RMB6, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x77}, .op=mnemonic::RMB7, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x87}, .op=mnemonic::SMB0, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x97}, .op=mnemonic::SMB1, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xA7}, .op=mnemonic::SMB2, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xB7}, .op=mnemonic::SMB3, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xC7}, .op=mnemonic::SMB4, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xD7}, .op=mnemonic::SMB5, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xE7}, .op=mnemonic::SMB6, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xF7}, .op=mnemonic::SMB7, .mode=address_mode::ZPAG, .length=2, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x0F}, .op=mnemonic::BBR0, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x1F}, .op=mnemonic::BBR1, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x2F}, .op=mnemonic::BBR2, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x3F}, .op=mnemonic::BBR3, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x4F}, .op=mnemonic::BBR4, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x5F}, .op=mnemonic::BBR5, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x6F}, .op=mnemonic::BBR6, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x7F}, .op=mnemonic::BBR7, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x8F}, .op=mnemonic::BBS0, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x9F}, .op=mnemonic::BBS1, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xAF}, .op=mnemonic::BBS2, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xBF}, .op=mnemonic::BBS3, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xCF}, .op=mnemonic::BBS4, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xDF}, .op=mnemonic::BBS5, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xEF}, .op=mnemonic::BBS6, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xFF}, .op=mnemonic::BBS7, .mode=address_mode::ZPRL, .length=3, .cycles=5, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x02}, .op=mnemonic::NOP, .mode=address_mode::IMME, .length=2, .cycles=2, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x22}, .op=mnemonic::NOP, .mode=address_mode::IMME, .length=2, .cycles=2, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x42}, .op=mnemonic::NOP, .mode=address_mode::IMME, .length=2, .cycles=2, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x62}, .op=mnemonic::NOP, .mode=address_mode::IMME, .length=2, .cycles=2, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x82}, .op=mnemonic::NOP, .mode=address_mode::IMME, .length=2, .cycles=2, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xC2}, .op=mnemonic::NOP, .mode=address_mode::IMME, .length=2, .cycles=2, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xE2}, .op=mnemonic::NOP, .mode=address_mode::IMME, .length=2, .cycles=2, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x44}, .op=mnemonic::NOP, .mode=address_mode::ZPAG, .length=2, .cycles=3, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x54}, .op=mnemonic::NOP, .mode=address_mode::ZPAX, .length=2, .cycles=4, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xD4}, .op=mnemonic::NOP, .mode=address_mode::ZPAX, .length=2, .cycles=4, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xF4}, .op=mnemonic::NOP, .mode=address_mode::ZPAX, .length=2, .cycles=4, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x5C}, .op=mnemonic::NOP, .mode=address_mode::ABSL, .length=3, .cycles=8, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xDC}, .op=mnemonic::NOP, .mode=address_mode::ABSL, .length=3, .cycles=4, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xFC}, .op=mnemonic::NOP, .mode=address_mode::ABSL, .length=3, .cycles=4, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x03}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x13}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x23}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x33}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x43}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x53}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x63}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x73}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x83}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x93}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xA3}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xB3}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xC3}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xD3}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xE3}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xF3}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x0B}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x1B}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x2B}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x3B}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x4B}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x5B}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x6B}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x7B}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x8B}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0x9B}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xAB}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xBB}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xEB}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  instruction{ .opcode=std::byte{0xFB}, .op=mnemonic::NOP, .mode=address_mode::IMPL, .length=1, .cycles=1, .set=instruction_set::CMOS },
+  // clang-format on
+};
 }; // namespace instruction_sets
 
 namespace penalty_opcodes {
@@ -329,6 +445,8 @@ INSTANTIATE_TEST_SUITE_P(stdn, decode_instruction, testing::ValuesIn(instruction
 
 INSTANTIATE_TEST_SUITE_P(nmos, decode_instruction, testing::ValuesIn(instruction_sets::nmos));
 
+INSTANTIATE_TEST_SUITE_P(cmos, decode_instruction, testing::ValuesIn(instruction_sets::cmos));
+
 TEST_P(decode_instruction, as_instruction) {
   auto expected = GetParam();
   auto actual = erelic::as_instruction(expected.opcode, expected.set);
@@ -345,6 +463,49 @@ TEST_P(decode_illegal_instruction, as_instruction) {
   EXPECT_EQ(expected, actual);
 }
 
+TEST(decode_instruction_table, matches_as_instruction) {
+  for (const auto set : {instruction_set::STND, instruction_set::NMOS, instruction_set::CMOS}) {
+    const auto &table = erelic::instruction_table_for(set);
+    for (auto opcode = 0U; opcode < std::size(table); ++opcode) {
+      const auto byte = std::byte{static_cast<unsigned char>(opcode)};
+      EXPECT_EQ(erelic::as_instruction(byte, table), erelic::as_instruction(byte, set));
+    }
+  }
+}
+
+TEST(decode_instruction_table, cmos_keeps_standard_opcodes) {
+  const auto &table = erelic::instruction_table_for(instruction_set::CMOS);
+  for (const auto &expected : instruction_sets::stnd) {
+    const auto &actual = erelic::as_instruction(expected.opcode, table);
+    if (actual.set == instruction_set::STND) {
+      EXPECT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST(decode_instruction_table, cmos_marks_only_changed_opcodes) {
+  const auto &table = erelic::instruction_table_for(instruction_set::CMOS);
+  const auto changed = std::ranges::count(table, instruction_set::CMOS, &instruction::set);
+  EXPECT_EQ(changed, std::ssize(instruction_sets::cmos));
+}
+
+TEST(calculate_cmos_cycle_penalty, cycles_with_penalty) {
+  const auto &table = erelic::instruction_table_for(instruction_set::CMOS);
+  const auto penalty = [&](unsigned opcode) {
+    const auto &instruction = erelic::as_instruction(std::byte{static_cast<unsigned char>(opcode)}, table);
+    return std::pair{erelic::cycles_with_penalty(instruction, page_boundary::SAME),
+                     erelic::cycles_with_penalty(instruction, page_boundary::NEXT)};
+  };
+
+  EXPECT_EQ(penalty(0x1E), std::pair(size_t{6}, size_t{7}));
+  EXPECT_EQ(penalty(0xFE), std::pair(size_t{7}, size_t{7}));
+  EXPECT_EQ(penalty(0x3C), std::pair(size_t{4}, size_t{5}));
+  EXPECT_EQ(penalty(0x80), std::pair(size_t{3}, size_t{4}));
+  EXPECT_EQ(penalty(0x0F), std::pair(size_t{6}, size_t{7}));
+  EXPECT_EQ(penalty(0xB2), std::pair(size_t{5}, size_t{5}));
+  EXPECT_EQ(penalty(0x7C), std::pair(size_t{6}, size_t{6}));
+}
+
 class calculate_cycle_penalty : public testing::TestWithParam<std::tuple<penalty_opcodes::type, std::byte>> {};
 
 INSTANTIATE_TEST_SUITE_P(NEVER_CROSS, calculate_cycle_penalty,
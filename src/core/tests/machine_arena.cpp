@@ -0,0 +1,148 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+#include "direct_pages.hpp"
+#include "machine_arena.hpp"
+
+using namespace erelic;
+
+namespace {
+struct latch_device {
+  std::byte value{0x00};
+  int *destroyed = nullptr;
+
+  latch_device() = default;
+  explicit latch_device(int &destroyed) : destroyed{&destroyed} {}
+  latch_device(const latch_device &) = default;
+  latch_device(latch_device &&) = default;
+  auto operator=(const latch_device &) -> latch_device & = default;
+  auto operator=(latch_device &&) -> latch_device & = default;
+  ~latch_device() {
+    if (destroyed != nullptr) {
+      ++*destroyed;
+    }
+  }
+
+  [[nodiscard]] auto read(address /*unused*/, address /*unused*/) const noexcept -> std::byte { return value; }
+  [[nodiscard]] auto write(address /*unused*/, address /*unused*/, std::byte v) noexcept -> write_status {
+    value = v;
+    return write_status::WRITTEN;
+  }
+};
+
+constexpr auto ram_range = address_range{address{0x0000}, address{0x07FF}};
+constexpr auto latch_range = address_range{address{0x4000}, address{0x4000}};
+
+static_assert(memory_device<ram_view>);
+static_assert(pollable_device<ram_view>);
+}; // namespace
+
+TEST(machine_arena, places_machine_devices_and_ram_in_one_block) {
+  auto arena = machine_arena{0x4000};
+  auto builder = machine_builder{arena};
+  const auto ram = builder.ram(ram_range);
+  auto &latch = builder.map<latch_device>(latch_range);
+  auto &m = builder.build();
+
+  EXPECT_TRUE(arena.owns(&m));
+  EXPECT_TRUE(arena.owns(&m.cpu));
+  EXPECT_TRUE(arena.owns(&latch));
+  EXPECT_TRUE(arena.owns(ram.data()));
+  EXPECT_TRUE(arena.owns(&ram.back()));
+  EXPECT_FALSE(arena.owns(&arena));
+  EXPECT_LE(arena.used(), arena.capacity());
+}
+
+TEST(machine_arena, bus_reaches_arena_devices) {
+  auto arena = machine_arena{0x4000};
+  auto builder = machine_builder{arena};
+  const auto ram = builder.ram(ram_range);
+  auto &latch = builder.map<latch_device>(latch_range);
+  auto &m = builder.build();
+
+  EXPECT_EQ(m.memory.read(address{0x0123}), std::byte{0x00});
+  EXPECT_EQ(m.memory.write(address{0x0123}, std::byte{0xAB}), write_status::WRITTEN);
+  EXPECT_EQ(ram[0x0123], std::byte{0xAB});
+
+  EXPECT_EQ(m.memory.write(address{0x4000}, std::byte{0x5C}), write_status::WRITTEN);
+  EXPECT_EQ(latch.value, std::byte{0x5C});
+  EXPECT_EQ(m.memory.device_count(), 2U);
+}
+
+TEST(machine_arena, ram_binds_for_direct_pages) {
+  auto arena = machine_arena{0x4000};
+  auto builder = machine_builder{arena};
+  const auto ram = builder.ram(ram_range);
+  auto pages = direct_pages{builder.build().memory};
+
+  ASSERT_TRUE(pages.zero_page_direct());
+  ASSERT_TRUE(pages.stack_direct());
+  EXPECT_EQ(pages.write_stack(0xFD, std::byte{0x42}), write_status::WRITTEN);
+  EXPECT_EQ(ram[0x01FD], std::byte{0x42});
+}
+
+TEST(machine_arena, reset_destroys_objects_and_reuses_block) {
+  auto arena = machine_arena{0x4000};
+  auto destroyed = 0;
+  {
+    auto builder = machine_builder{arena};
+    builder.ram(ram_range);
+    builder.map<latch_device>(latch_range, destroyed);
+  }
+  const auto used = arena.used();
+  EXPECT_GT(used, ram_range.size());
+
+  arena.reset();
+  EXPECT_EQ(destroyed, 1);
+  EXPECT_EQ(arena.used(), 0U);
+
+  auto builder = machine_builder{arena};
+  const auto ram = builder.ram(ram_range);
+  builder.map<latch_device>(latch_range, destroyed);
+  EXPECT_EQ(arena.used(), used);
+  EXPECT_EQ(ram[0x0123], std::byte{0x00});
+}
+
+TEST(machine_arena, destructor_destroys_objects) {
+  auto destroyed = 0;
+  {
+    auto arena = machine_arena{0x1000};
+    arena.create<latch_device>(destroyed);
+    arena.create<latch_device>(destroyed);
+  }
+  EXPECT_EQ(destroyed, 2);
+}
+
+TEST(machine_arena, bytes_are_aligned) {
+  auto arena = machine_arena{0x1000};
+  arena.create<std::byte>();
+  const auto block = arena.bytes(0x10, 0x40);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block.data()) % 0x40, 0U);
+}
+
+TEST(machine_arena, throws_when_exhausted) {
+  // Room for the machine itself but not for its RAM.
+  auto arena = machine_arena{sizeof(machine) + 0x400};
+  auto builder = machine_builder{arena};
+  EXPECT_THROW(builder.ram(ram_range), std::bad_alloc);
+}
+
+TEST(machine_arena, serves_pmr_containers) {
+  auto arena = machine_arena{0x1000};
+  auto values = std::pmr::vector<int>{&arena};
+  values.assign(16, 7);
+  EXPECT_TRUE(arena.owns(values.data()));
+  EXPECT_THROW(values.resize(0x1000), std::bad_alloc);
+}
@@ -0,0 +1,156 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+#include "memory_view.hpp"
+#include "registers.hpp"
+
+using namespace erelic;
+
+namespace {
+struct ram_mock {
+  std::vector<std::byte> cells = std::vector<std::byte>(0x1000);
+
+  [[nodiscard]] auto read(address /*unused*/, address r) const noexcept -> std::byte { return cells[r.raw]; }
+  [[nodiscard]] auto write(address /*unused*/, address r, std::byte v) noexcept -> write_status {
+    cells[r.raw] = v;
+    return write_status::WRITTEN;
+  }
+  [[nodiscard]] auto memory() noexcept -> std::span<std::byte> { return cells; }
+};
+
+// Register with read side effects, counted in `accesses`.
+struct io_mock {
+  std::size_t *accesses;
+
+  [[nodiscard]] auto read(address /*unused*/, address /*unused*/) const noexcept -> std::byte {
+    ++*accesses;
+    return std::byte{0xFF};
+  }
+  [[nodiscard]] auto write(address /*unused*/, address /*unused*/, std::byte /*unused*/) noexcept -> write_status {
+    ++*accesses;
+    return write_status::WRITTEN;
+  }
+};
+
+auto make_bus(std::size_t &accesses) -> bus {
+  auto b = bus{};
+  b.map(address_range{address{0x0000}, address{0x0FFF}}, device{ram_mock{}});
+  b.map(address_range{address{0xD000}, address{0xD0FF}}, device{io_mock{&accesses}});
+  return b;
+}
+}; // namespace
+
+TEST(memory_view, starts_with_power_on_registers) {
+  const auto view = memory_view{};
+  const auto snap = view.snapshot(address_range{address{0x0000}, address{0x0000}});
+  EXPECT_EQ(snap.generation, 0);
+  EXPECT_EQ(snap.cpu, registers{});
+}
+
+TEST(memory_view, snapshot_reflects_last_publish) {
+  auto accesses = std::size_t{0};
+  auto b = make_bus(accesses);
+  (void)b.write(address{0x0000}, std::byte{0x11});
+  (void)b.write(address{0x0FFF}, std::byte{0x22});
+  accesses = 0;
+
+  auto view = memory_view{};
+  const auto cpu = registers{.a = std::byte{1}, .x = std::byte{2}, .y = std::byte{3}, .pc = address{0xC123}};
+  view.publish(cpu, 1234, b);
+
+  const auto snap = view.snapshot();
+  EXPECT_EQ(snap.generation, 1);
+  EXPECT_EQ(snap.cpu, cpu);
+  EXPECT_EQ(snap.cycle, 1234);
+  ASSERT_EQ(snap.memory.size(), address_space_size);
+  EXPECT_EQ(snap.memory[0x0000], std::byte{0x11});
+  EXPECT_EQ(snap.memory[0x0FFF], std::byte{0x22});
+  EXPECT_EQ(snap.memory[0xD000], std::byte{0x00});
+  EXPECT_EQ(accesses, 0);
+}
+
+TEST(memory_view, republishes_every_change_the_bus_sees) {
+  auto accesses = std::size_t{0};
+  auto b = make_bus(accesses);
+  auto view = memory_view{};
+  view.publish({}, 0, b);
+
+  // A device or DMA writing through the bus, and another consumer clearing the dirty pages in between.
+  (void)b.write(address{0x0210}, std::byte{0xAA});
+  b.clear_dirty_pages();
+  // The core writing through a bound page.
+  auto zero = b.bind_page(0x00);
+  ASSERT_FALSE(zero.empty());
+  zero[0x10] = std::byte{0xBB};
+  view.publish({}, 0, b);
+
+  EXPECT_EQ(view.snapshot().memory[0x0210], std::byte{0xAA});
+  EXPECT_EQ(view.snapshot().memory[0x0010], std::byte{0xBB});
+
+  zero[0x10] = std::byte{0xCC};
+  view.publish({}, 0, b);
+  EXPECT_EQ(view.snapshot().memory[0x0010], std::byte{0xCC});
+}
+
+TEST(memory_view, snapshot_of_unaligned_range) {
+  auto accesses = std::size_t{0};
+  auto b = make_bus(accesses);
+  for (auto i = address_raw{0}; i < 0x1000; ++i) {
+    (void)b.write(address{i}, static_cast<std::byte>(i * 7));
+  }
+  auto view = memory_view{};
+  view.publish({}, 0, b);
+
+  const auto snap = view.snapshot(address_range{address{0x01FB}, address{0x0203}});
+  EXPECT_EQ(snap.generation, 1);
+  ASSERT_EQ(snap.memory.size(), 9);
+  for (auto i = address_raw{0}; i < 9; ++i) {
+    EXPECT_EQ(snap.memory[i], b.read(address{static_cast<address_raw>(0x01FB + i)}));
+  }
+  EXPECT_EQ(view.snapshot(address_range{address{0xFFFF}, address{0xFFFF}}).memory, std::vector{std::byte{0}});
+}
+
+TEST(memory_view, observer_sees_consistent_snapshots) {
+  auto accesses = std::size_t{0};
+  auto b = make_bus(accesses);
+  auto view = memory_view{};
+  auto done = std::atomic<bool>{false};
+
+  auto observer = std::thread{[&] {
+    while (!done.load(std::memory_order_relaxed)) {
+      const auto snap = view.snapshot(address_range{address{0x0000}, address{0x0FFF}});
+      const auto value = static_cast<std::byte>(snap.cycle);
+      ASSERT_EQ(snap.cpu.a, value);
+      ASSERT_EQ(snap.cycle, snap.generation == 0 ? 0 : snap.generation - 1);
+      ASSERT_TRUE(std::ranges::all_of(snap.memory, [value](std::byte v) { return v == value; }));
+    }
+  }};
+
+  auto pages = std::vector<std::span<std::byte>>{};
+  for (auto page = std::size_t{0}; page < 0x10; ++page) {
+    pages.push_back(b.bind_page(page));
+  }
+  for (std::uint64_t i = 0; i < 10'000; ++i) {
+    const auto value = static_cast<std::byte>(i);
+    for (const auto page : pages) {
+      std::ranges::fill(page, value);
+    }
+    view.publish(registers{.a = value}, i, b);
+  }
+  done = true;
+  observer.join();
+}
@@ -0,0 +1,216 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+#include "instruction.hpp"
+#include "micro_ops.hpp"
+#include "registers.hpp"
+
+using namespace erelic;
+
+namespace {
+enum class bus_access {
+  READ,
+  WRIT,
+};
+
+struct recording_bus {
+  std::vector<std::byte> memory = std::vector<std::byte>(address_space_size);
+  mutable std::vector<std::pair<bus_access, address_raw>> log;
+
+  [[nodiscard]] auto read(address a) const noexcept -> std::byte {
+    log.emplace_back(bus_access::READ, a.raw);
+    return memory[a.raw];
+  }
+  [[nodiscard]] auto write(address a, std::byte v) noexcept -> write_status {
+    log.emplace_back(bus_access::WRIT, a.raw);
+    memory[a.raw] = v;
+    return write_status::WRITTEN;
+  }
+};
+
+struct core_mock {
+  bool take = true;
+  std::byte result{0x5A};
+
+  [[nodiscard]] auto execute(const instruction & /*unused*/, std::byte /*unused*/, address /*unused*/) noexcept
+    -> std::byte {
+    return result;
+  }
+  [[nodiscard]] auto taken(const instruction &info, std::byte /*unused*/) noexcept -> bool {
+    return take || info.op == mnemonic::BRA;
+  }
+};
+
+static_assert(io_bus<recording_bus>);
+static_assert(micro_core<core_mock>);
+
+constexpr auto origin = address_raw{0x0200};
+
+// Runs the opcode at `origin` once. With `crossing` every indexed access and taken branch crosses a page.
+auto run_once(instruction_set set, std::uint8_t opcode, bool crossing, bool take)
+  -> std::pair<std::size_t, std::size_t> {
+  auto b = recording_bus{};
+  const auto operand = crossing ? std::byte{0x80} : std::byte{0x04};
+  b.memory[origin] = std::byte{opcode};
+  b.memory[origin + 1] = operand;
+  b.memory[origin + 2] = operand;
+  b.memory[0x80] = operand;
+  b.memory[0x81] = operand;
+  const auto index = crossing ? std::byte{0x90} : std::byte{0x01};
+  auto regs = registers{.x = index, .y = index, .pc = address{origin}};
+  auto core = core_mock{.take = take};
+  auto engine = micro_engine{b, core, regs, set};
+  const auto cycles = engine.step();
+  return {cycles, b.log.size()};
+}
+}; // namespace
+
+TEST(micro_ops, cycles_match_cycles_with_penalty) {
+  for (const auto set : {instruction_set::STND, instruction_set::NMOS, instruction_set::CMOS}) {
+    const auto &table = instruction_table_for(set);
+    for (auto opcode = 0U; opcode < table.size(); ++opcode) {
+      const auto &info = table[opcode];
+      if (info.cycles == 0) {
+        continue;
+      }
+      const auto branch = info.mode == address_mode::RELA || info.mode == address_mode::ZPRL;
+      for (const auto crossing : {false, true}) {
+        const auto relation = crossing ? page_boundary::NEXT : page_boundary::SAME;
+        const auto [cycles, accesses] = run_once(set, static_cast<std::uint8_t>(opcode), crossing, true);
+        EXPECT_EQ(cycles, cycles_with_penalty(info, relation)) << set << " " << info << " crossing=" << crossing;
+        EXPECT_EQ(accesses, cycles) << set << " " << info;
+      }
+      if (branch && info.op != mnemonic::BRA) {
+        const auto [cycles, accesses] = run_once(set, static_cast<std::uint8_t>(opcode), true, false);
+        EXPECT_EQ(cycles, info.cycles) << set << " " << info;
+        EXPECT_EQ(accesses, cycles) << set << " " << info;
+      }
+    }
+  }
+}
+
+TEST(micro_ops, indexed_read_issues_dummy_read_on_page_cross) {
+  auto b = recording_bus{};
+  b.memory[origin] = std::byte{0xBD}; // LDA $12F0,X
+  b.memory[origin + 1] = std::byte{0xF0};
+  b.memory[origin + 2] = std::byte{0x12};
+  auto regs = registers{.x = std::byte{0x20}, .pc = address{origin}};
+  auto core = core_mock{};
+  auto engine = micro_engine{b, core, regs, instruction_set::NMOS};
+
+  EXPECT_EQ(engine.step(), 5U);
+  const auto expected = std::vector<std::pair<bus_access, address_raw>>{
+    {bus_access::READ, 0x0200}, {bus_access::READ, 0x0201}, {bus_access::READ, 0x0202},
+    {bus_access::READ, 0x1210}, {bus_access::READ, 0x1310},
+  };
+  EXPECT_EQ(b.log, expected);
+  EXPECT_EQ(regs.pc.raw, 0x0203);
+}
+
+TEST(micro_ops, read_modify_write_dummy_access_depends_on_set) {
+  for (const auto set : {instruction_set::NMOS, instruction_set::CMOS}) {
+    auto b = recording_bus{};
+    b.memory[origin] = std::byte{0xEE}; // INC $1234
+    b.memory[origin + 1] = std::byte{0x34};
+    b.memory[origin + 2] = std::byte{0x12};
+    b.memory[0x1234] = std::byte{0x41};
+    auto regs = registers{.pc = address{origin}};
+    auto core = core_mock{};
+    auto engine = micro_engine{b, core, regs, set};
+
+    EXPECT_EQ(engine.step(), 6U);
+    const auto dummy = set == instruction_set::NMOS ? bus_access::WRIT : bus_access::READ;
+    const auto expected = std::vector<std::pair<bus_access, address_raw>>{
+      {bus_access::READ, 0x0200}, {bus_access::READ, 0x0201}, {bus_access::READ, 0x0202},
+      {bus_access::READ, 0x1234}, {dummy, 0x1234},        {bus_access::WRIT, 0x1234},
+    };
+    EXPECT_EQ(b.log, expected) << set;
+    EXPECT_EQ(b.memory[0x1234], core.result);
+  }
+}
+
+TEST(micro_ops, subroutine_round_trip) {
+  auto b = recording_bus{};
+  b.memory[origin] = std::byte{0x20}; // JSR $1234
+  b.memory[origin + 1] = std::byte{0x34};
+  b.memory[origin + 2] = std::byte{0x12};
+  b.memory[0x1234] = std::byte{0x60}; // RTS
+  auto regs = registers{.pc = address{origin}};
+  auto core = core_mock{};
+  auto engine = micro_engine{b, core, regs, instruction_set::STND};
+
+  EXPECT_EQ(engine.step(), 6U);
+  EXPECT_EQ(regs.pc.raw, 0x1234);
+  EXPECT_EQ(regs.s, std::byte{0xFB});
+  EXPECT_EQ(b.memory[0x01FD], std::byte{0x02});
+  EXPECT_EQ(b.memory[0x01FC], std::byte{0x02});
+
+  EXPECT_EQ(engine.step(), 6U);
+  EXPECT_EQ(regs.pc.raw, 0x0203);
+  EXPECT_EQ(regs.s, std::byte{0xFD});
+}
+
+TEST(micro_ops, taken_branch_across_page) {
+  auto b = recording_bus{};
+  b.memory[origin] = std::byte{0xD0}; // BNE -128
+  b.memory[origin + 1] = std::byte{0x80};
+  auto regs = registers{.pc = address{origin}};
+  auto core = core_mock{};
+  auto engine = micro_engine{b, core, regs, instruction_set::NMOS};
+
+  EXPECT_EQ(engine.step(), 4U);
+  EXPECT_EQ(regs.pc.raw, 0x0182);
+  EXPECT_EQ(b.log.back(), std::pair(bus_access::READ, address_raw{0x0282}));
+}
+
+TEST(micro_ops, tick_reports_instruction_boundaries) {
+  auto b = recording_bus{};
+  b.memory[origin] = std::byte{0xA9}; // LDA #$00
+  b.memory[origin + 2] = std::byte{0xEA};
+  auto regs = registers{.pc = address{origin}};
+  auto core = core_mock{};
+  auto engine = micro_engine{b, core, regs, instruction_set::STND};
+
+  EXPECT_FALSE(engine.tick());
+  EXPECT_TRUE(engine.tick());
+  EXPECT_EQ(engine.current().op, mnemonic::LDA);
+  EXPECT_FALSE(engine.tick());
+  EXPECT_TRUE(engine.tick());
+  EXPECT_EQ(engine.current().op, mnemonic::NOP);
+}
+
+TEST(micro_ops, jam_never_completes) {
+  auto b = recording_bus{};
+  b.memory[origin] = std::byte{0x02};
+  auto regs = registers{.pc = address{origin}};
+  auto core = core_mock{};
+  auto engine = micro_engine{b, core, regs, instruction_set::NMOS};
+
+  EXPECT_EQ(engine.step(), 1U);
+  EXPECT_TRUE(engine.jammed());
+  for (auto i = 0; i < 10; ++i) {
+    EXPECT_FALSE(engine.tick());
+  }
+  EXPECT_EQ(b.log.size(), 11U);
+  EXPECT_EQ(b.log.back(), std::pair(bus_access::READ, address_raw{0xFFFF}));
+}
+
+TEST(micro_ops, programs_start_with_opcode_fetch) {
+  for (const auto set : {instruction_set::STND, instruction_set::NMOS, instruction_set::CMOS}) {
+    for (const auto &program : micro_program_table_for(set)) {
+      ASSERT_GE(program.size, 1U);
+      EXPECT_EQ(program.ops[0], micro_op::FOPC);
+    }
+  }
+}
@@ -0,0 +1,128 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "pacer.hpp"
+
+using namespace erelic;
+using namespace std::chrono_literals;
+
+namespace {
+struct fake_time {
+  pacing_time now{};
+  std::chrono::nanoseconds cpu{0};
+  // Added to every sleep, as a loaded host would.
+  std::chrono::nanoseconds oversleep{0};
+  std::vector<pacing_time> sleeps{};
+
+  // Emulation cost of a slice.
+  void burn(std::chrono::nanoseconds duration) {
+    now += duration;
+    cpu += duration;
+  }
+};
+
+struct fake_clock {
+  fake_time *t;
+
+  [[nodiscard]] auto now() const noexcept -> pacing_time { return t->now; }
+  void sleep_until(pacing_time until) const {
+    t->sleeps.push_back(until);
+    t->now = std::max(t->now, until + t->oversleep);
+  }
+  void spin() const noexcept { t->burn(1us); }
+  [[nodiscard]] auto cpu_time() const noexcept -> std::chrono::nanoseconds { return t->cpu; }
+};
+
+static_assert(pacing_clock<fake_clock>);
+}; // namespace
+
+TEST(pacer, runs_at_clock_rate_without_busy_waiting) {
+  // 1 MHz in 2000-cycle slices: 2 ms per slice, 200 us of it emulating.
+  auto t = fake_time{};
+  auto p = pacer{1'000'000, 2000, 100us, 50ms, fake_clock{&t}};
+  auto executed = std::uint64_t{0};
+
+  const auto begin = t.now;
+  for (auto i = 0; i < 25; ++i) {
+    p.step([&](std::uint64_t cycles) {
+      t.burn(200us);
+      executed += cycles;
+      return cycles;
+    });
+  }
+
+  EXPECT_EQ(executed, 50'000);
+  EXPECT_EQ(t.now - begin, 50ms);
+  ASSERT_EQ(t.sleeps.size(), 25);
+  EXPECT_EQ(t.sleeps[0], begin + 2ms - 100us);
+  EXPECT_EQ(t.sleeps[24], begin + 50ms - 100us);
+
+  const auto &stats = p.statistics();
+  EXPECT_EQ(stats.slices, 25);
+  EXPECT_EQ(stats.overruns, 0);
+  EXPECT_EQ(stats.max_jitter, 0ns);
+  // 200 us of emulation and 100 us of spinning per 2 ms.
+  EXPECT_DOUBLE_EQ(stats.cpu_usage, 0.15);
+}
+
+TEST(pacer, reports_wake_up_jitter) {
+  auto t = fake_time{.oversleep = 150us};
+  auto p = pacer{1'000'000, 1000, 100us, 50ms, fake_clock{&t}};
+  for (auto i = 0; i < 4; ++i) {
+    p.step([](std::uint64_t cycles) { return cycles; });
+  }
+  EXPECT_EQ(p.statistics().max_jitter, 50us);
+  EXPECT_EQ(p.statistics().mean_jitter, 50us);
+  EXPECT_EQ(p.statistics().overruns, 0);
+}
+
+TEST(pacer, overshooting_slices_are_charged) {
+  auto t = fake_time{};
+  auto p = pacer{1'000'000, 1000, 100us, 50ms, fake_clock{&t}};
+  const auto begin = t.now;
+  for (auto i = 0; i < 10; ++i) {
+    p.step([](std::uint64_t cycles) { return cycles + 1000; });
+  }
+  EXPECT_EQ(t.now - begin, 20ms);
+}
+
+TEST(pacer, resyncs_instead_of_bursting_after_a_stall) {
+  auto t = fake_time{};
+  auto p = pacer{1'000'000, 1000, 100us, 5ms, fake_clock{&t}};
+  p.step([&](std::uint64_t cycles) {
+    t.burn(20ms);
+    return cycles;
+  });
+  EXPECT_EQ(p.statistics().overruns, 1);
+  EXPECT_EQ(p.statistics().resyncs, 1);
+
+  const auto begin = t.now;
+  for (auto i = 0; i < 5; ++i) {
+    p.step([](std::uint64_t cycles) { return cycles; });
+  }
+  EXPECT_EQ(t.now - begin, 5ms);
+  EXPECT_EQ(p.statistics().overruns, 1);
+}
+
+TEST(pacer, host_clock_never_runs_early) {
+  auto p = pacer{1'000'000, 1000};
+  const auto begin = host_clock::now();
+  for (auto i = 0; i < 5; ++i) {
+    p.step([](std::uint64_t cycles) { return cycles; });
+  }
+  EXPECT_GE(host_clock::now() - begin, 5ms);
+}
+
+TEST(pacer, rejects_zero_rate) {
+  EXPECT_THROW((pacer{0, 1000}), std::invalid_argument);
+  EXPECT_THROW((pacer{1'000'000, 0}), std::invalid_argument);
+}
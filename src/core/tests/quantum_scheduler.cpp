@@ -0,0 +1,255 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "address.hpp"
+#include "device.hpp"
+#include "quantum_scheduler.hpp"
+#include "shared_memory.hpp"
+
+using namespace erelic;
+
+namespace {
+using mailbox = shared_memory<4>;
+
+// Host CPU: every 7-cycle "instruction" posts a counter to the mailbox while the drive is in a transfer phase.
+// Drive CPU: 3- to 9-cycle instructions that fold whatever it reads and the cycle into a checksum, acknowledge new
+// values through byte 1 and note the cycle each one arrived at.
+struct mock_cpu {
+  std::uint64_t cycle = 0;
+  device port;
+  bool host;
+  std::uint64_t checksum = 0;
+  unsigned counter = 0;
+  std::vector<unsigned> received{};
+  std::vector<std::uint64_t> arrivals{};
+
+  mock_cpu(mailbox &box, std::size_t index, bool host)
+      : port{box.port_for(index, cycle)}, host{host} {}
+
+  auto run_until(std::uint64_t target) -> std::uint64_t {
+    while (cycle < target) {
+      if (host) {
+        const auto ack = std::to_integer<unsigned>(port.read(address{0}, address{1}));
+        if ((cycle / 500) % 2 == 0 && ack == (counter & 0xFFU)) {
+          ++counter;
+          (void)port.write(address{0}, address{0}, std::byte{static_cast<unsigned char>(counter)});
+        }
+        cycle += 7;
+      } else {
+        const auto value = port.read(address{0}, address{0});
+        checksum = checksum * 31 + std::to_integer<unsigned>(value) + cycle;
+        if (value != port.read(address{1}, address{1})) {
+          received.push_back(std::to_integer<unsigned>(value));
+          arrivals.push_back(cycle);
+          (void)port.write(address{1}, address{1}, value);
+        }
+        cycle += 3 + (checksum % 7);
+      }
+    }
+    return cycle;
+  }
+
+  void save_state(std::ostream &os) const {
+    os << cycle << ' ' << checksum << ' ' << counter << ' ' << received.size() << ' ';
+    for (std::size_t i = 0; i < received.size(); ++i) {
+      os << received[i] << ' ' << arrivals[i] << ' ';
+    }
+  }
+  void load_state(std::istream &is) {
+    auto count = std::size_t{0};
+    is >> cycle >> checksum >> counter >> count;
+    received.resize(count);
+    arrivals.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      is >> received[i] >> arrivals[i];
+    }
+  }
+};
+
+static_assert(quantum_cpu<mock_cpu>);
+static_assert(io_device<mailbox::port>);
+static_assert(quantum_shared<mailbox>);
+
+struct twin_system {
+  mailbox box{2};
+  mock_cpu host{box, 0, true};
+  mock_cpu drive{box, 1, false};
+  quantum_scheduler<mock_cpu> scheduler;
+
+  explicit twin_system(std::uint64_t min_quantum = 16, std::uint64_t max_quantum = 256)
+      : scheduler{{&host, &drive}, min_quantum, max_quantum, 1 << 16} {
+    scheduler.attach(box);
+  }
+};
+
+// Values the host posted in order, wrapping at a byte.
+auto posted(unsigned count) -> std::vector<unsigned> {
+  auto values = std::vector<unsigned>(count);
+  for (unsigned i = 0; i < count; ++i) {
+    values[i] = (i + 1) & 0xFFU;
+  }
+  return values;
+}
+}; // namespace
+
+TEST(quantum_scheduler, parallel_matches_serial) {
+  auto serial = twin_system{};
+  auto parallel = twin_system{};
+  for (std::uint64_t frame = 1; frame <= 20; ++frame) {
+    serial.scheduler.run_until(frame * 1000, execution_mode::SERIAL);
+    parallel.scheduler.run_until(frame * 1000, execution_mode::PARALLEL);
+  }
+
+  EXPECT_EQ(serial.scheduler.cycles(), 20'000);
+  EXPECT_EQ(parallel.scheduler.cycles(), 20'000);
+  EXPECT_GT(serial.host.counter, 0);
+  EXPECT_EQ(serial.host.counter, parallel.host.counter);
+  EXPECT_EQ(serial.drive.checksum, parallel.drive.checksum);
+  EXPECT_EQ(serial.host.cycle, parallel.host.cycle);
+  EXPECT_EQ(serial.drive.cycle, parallel.drive.cycle);
+  EXPECT_EQ(serial.box.contents(), parallel.box.contents());
+  EXPECT_EQ(serial.scheduler.quanta(), parallel.scheduler.quanta());
+}
+
+TEST(quantum_scheduler, parallel_workers_outlive_calls) {
+  auto serial = twin_system{};
+  auto parallel = twin_system{};
+  for (std::uint64_t step = 1; step <= 200; ++step) {
+    serial.scheduler.run_until(step * 100, execution_mode::SERIAL);
+    parallel.scheduler.run_until(step * 100, step % 3 == 0 ? execution_mode::SERIAL : execution_mode::PARALLEL);
+  }
+  EXPECT_EQ(serial.drive.checksum, parallel.drive.checksum);
+  EXPECT_EQ(serial.scheduler.quanta(), parallel.scheduler.quanta());
+}
+
+TEST(quantum_scheduler, lockstep_is_one_cycle_quanta) {
+  auto lockstep = twin_system{};
+  auto single = twin_system{1, 1};
+  lockstep.scheduler.run_until(3000, execution_mode::LOCKSTEP);
+  single.scheduler.run_until(3000, execution_mode::SERIAL);
+
+  EXPECT_EQ(lockstep.scheduler.quanta(), 3000);
+  EXPECT_EQ(lockstep.drive.checksum, single.drive.checksum);
+  EXPECT_EQ(lockstep.drive.received, single.drive.received);
+  EXPECT_EQ(lockstep.box.contents(), single.box.contents());
+}
+
+// The drive folds the cycle of every read into its checksum and notes when each value arrived, so any quantum that
+// delayed a write against the one-cycle reference would show up.
+TEST(quantum_scheduler, quanta_match_lockstep) {
+  auto lockstep = twin_system{};
+  auto serial = twin_system{};
+  auto parallel = twin_system{64, 1024};
+  lockstep.scheduler.run_until(20'000, execution_mode::LOCKSTEP);
+  serial.scheduler.run_until(20'000, execution_mode::SERIAL);
+  for (std::uint64_t frame = 1; frame <= 20; ++frame) {
+    parallel.scheduler.run_until(frame * 1000, execution_mode::PARALLEL);
+  }
+
+  ASSERT_FALSE(lockstep.drive.received.empty());
+  EXPECT_EQ(lockstep.drive.received, posted(lockstep.host.counter));
+  for (const auto *s : {&serial, &parallel}) {
+    EXPECT_GT(s->scheduler.reruns(), 0);
+    EXPECT_LT(s->scheduler.quanta(), lockstep.scheduler.quanta() / 4);
+    EXPECT_EQ(s->host.counter, lockstep.host.counter);
+    EXPECT_EQ(s->drive.received, lockstep.drive.received);
+    EXPECT_EQ(s->drive.arrivals, lockstep.drive.arrivals);
+    EXPECT_EQ(s->drive.checksum, lockstep.drive.checksum);
+    EXPECT_EQ(s->host.cycle, lockstep.host.cycle);
+    EXPECT_EQ(s->drive.cycle, lockstep.drive.cycle);
+    EXPECT_EQ(s->box.contents(), lockstep.box.contents());
+  }
+}
+
+// A quantum that ran past a write the other CPU read is discarded and run again up to that write.
+TEST(quantum_scheduler, conflicts_end_the_quantum_after_the_write) {
+  auto box = mailbox{2};
+  auto writer_clock = std::uint64_t{3};
+  auto reader_clock = std::uint64_t{9};
+  auto writer = box.port_for(0, writer_clock);
+  const auto reader = box.port_for(1, reader_clock);
+  (void)writer.write(address{0}, address{0}, std::byte{0x11});
+  (void)reader.read(address{0}, address{0});
+  EXPECT_EQ(box.first_conflict(), 4);
+
+  box.discard();
+  EXPECT_EQ(box.first_conflict(), std::nullopt);
+  EXPECT_FALSE(box.commit());
+
+  // Reading before or in the cycle of the write matches the reference.
+  reader_clock = 3;
+  (void)reader.read(address{0}, address{0});
+  (void)writer.write(address{0}, address{0}, std::byte{0x11});
+  EXPECT_EQ(box.first_conflict(), std::nullopt);
+}
+
+TEST(quantum_scheduler, quantum_adapts_to_traffic) {
+  auto s = twin_system{};
+  // Transfer phase: the CPUs exchange data every quantum.
+  s.scheduler.run_until(480, execution_mode::SERIAL);
+  EXPECT_EQ(s.scheduler.current_quantum(), 16);
+
+  // Quiet phase: the host stops posting.
+  s.scheduler.run_until(1000, execution_mode::SERIAL);
+  EXPECT_EQ(s.scheduler.current_quantum(), 256);
+}
+
+TEST(quantum_scheduler, own_writes_are_visible_before_commit) {
+  auto box = mailbox{2};
+  auto clock = std::uint64_t{5};
+  auto mine = box.port_for(0, clock);
+  const auto other = box.port_for(1, clock);
+
+  EXPECT_EQ(mine.write(address{0}, address{2}, std::byte{0x42}), write_status::WRITTEN);
+  EXPECT_EQ(mine.read(address{0}, address{2}), std::byte{0x42});
+  EXPECT_EQ(other.read(address{0}, address{2}), std::byte{0x00});
+
+  EXPECT_TRUE(box.commit());
+  EXPECT_EQ(other.read(address{0}, address{2}), std::byte{0x42});
+  EXPECT_FALSE(box.commit());
+}
+
+TEST(quantum_scheduler, last_write_of_a_quantum_wins) {
+  auto box = mailbox{2};
+  auto clock = std::uint64_t{0};
+  auto mine = box.port_for(0, clock);
+  for (; clock < 10'000; ++clock) {
+    (void)mine.write(address{0}, address{static_cast<address_raw>(clock % 4)}, static_cast<std::byte>(clock));
+  }
+  EXPECT_EQ(mine.read(address{0}, address{3}), static_cast<std::byte>(9'999));
+  EXPECT_TRUE(box.commit());
+  EXPECT_EQ(box.contents(), (std::array{static_cast<std::byte>(9'996), static_cast<std::byte>(9'997),
+                                        static_cast<std::byte>(9'998), static_cast<std::byte>(9'999)}));
+}
+
+TEST(quantum_scheduler, commits_in_cycle_then_cpu_order) {
+  auto box = mailbox{2};
+  auto early = std::uint64_t{10};
+  auto late = std::uint64_t{20};
+  auto a = box.port_for(0, late);
+  auto b = box.port_for(1, early);
+  (void)a.write(address{0}, address{0}, std::byte{0xAA});
+  (void)b.write(address{0}, address{0}, std::byte{0xBB});
+  (void)box.commit();
+  EXPECT_EQ(box.contents()[0], std::byte{0xAA});
+}
+
+TEST(quantum_scheduler, rejects_bad_configuration) {
+  EXPECT_THROW((quantum_scheduler<mock_cpu>{{}, 1, 2, 64}), std::invalid_argument);
+  auto box = mailbox{1};
+  auto cpu = mock_cpu{box, 0, true};
+  EXPECT_THROW((quantum_scheduler<mock_cpu>{{&cpu}, 0, 2, 64}), std::invalid_argument);
+  EXPECT_THROW((quantum_scheduler<mock_cpu>{{&cpu}, 8, 4, 64}), std::invalid_argument);
+}
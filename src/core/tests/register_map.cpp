@@ -0,0 +1,98 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <utility>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+#include "register_map.hpp"
+#include "static_bus.hpp"
+
+using namespace erelic;
+
+namespace {
+// Serial port: data register popping a receive byte on read, status clearing on read, free-running baud counter and
+// a plain control register.
+struct serial_state {
+  std::byte received{0x41};
+  std::byte sent{0x00};
+  std::byte status{0x80};
+  std::byte control{0x00};
+  std::uint64_t reload = 100;
+
+  constexpr auto pop() noexcept -> std::byte {
+    status = std::byte{0x00};
+    return received;
+  }
+  constexpr void push(std::byte v) noexcept { sent = v; }
+  constexpr auto read_status() noexcept -> std::byte { return std::exchange(status, std::byte{0x00}); }
+  [[nodiscard]] constexpr auto counter() const noexcept -> std::byte { return std::byte{0x17}; }
+  constexpr auto write_counter(std::byte v) noexcept -> write_status {
+    return v == std::byte{0x00} ? write_status::FAILED : write_status::WRITTEN;
+  }
+  [[nodiscard]] auto stable_until(address /*unused*/, std::uint64_t now) const noexcept -> std::uint64_t {
+    return now + reload;
+  }
+};
+
+using serial = register_device<serial_state,
+                               reg<0x0, &serial_state::pop, &serial_state::push, register_effect::RDSE>,
+                               reg<0x1, &serial_state::read_status, nullptr, register_effect::RDSE>,
+                               reg<0x2, &serial_state::counter, &serial_state::write_counter, register_effect::VOLA>,
+                               reg<0x3, &serial_state::control, &serial_state::control>,
+                               reg<0x5, nullptr, &serial_state::sent>>;
+
+static_assert(io_device<serial>);
+static_assert(pollable_device<serial>);
+static_assert(serial::register_span == 6);
+static_assert(!serial::side_effect_free(address{0x0}));
+static_assert(serial::side_effect_free(address{0x2}) && !serial::cacheable(address{0x2}));
+static_assert(serial::cacheable(address{0x3}));
+static_assert([] {
+  auto b = static_bus<mapping<address_range{address{0xD000}, address{0xD00F}}, serial>>{};
+  return b.read(address{0xD002}) == std::byte{0x17};
+}());
+}; // namespace
+
+TEST(register_map, dispatches_by_offset) {
+  auto dev = serial{};
+  EXPECT_EQ(dev.read(address{0xD001}, address{0x1}), std::byte{0x80});
+  EXPECT_EQ(dev.read(address{0xD001}, address{0x1}), std::byte{0x00});
+  EXPECT_EQ(dev.read(address{0xD000}, address{0x0}), std::byte{0x41});
+
+  EXPECT_EQ(dev.write(address{0xD000}, address{0x0}, std::byte{0x55}), write_status::WRITTEN);
+  EXPECT_EQ(dev.get().sent, std::byte{0x55});
+  EXPECT_EQ(dev.write(address{0xD003}, address{0x3}, std::byte{0x0F}), write_status::WRITTEN);
+  EXPECT_EQ(dev.read(address{0xD003}, address{0x3}), std::byte{0x0F});
+  EXPECT_EQ(dev.write(address{0xD002}, address{0x2}, std::byte{0x00}), write_status::FAILED);
+  EXPECT_EQ(dev.write(address{0xD002}, address{0x2}, std::byte{0x01}), write_status::WRITTEN);
+}
+
+TEST(register_map, unlisted_and_one_way_registers) {
+  auto dev = serial{};
+  EXPECT_EQ(dev.write(address{0xD001}, address{0x1}, std::byte{0x01}), write_status::IGNORED);
+  EXPECT_EQ(dev.read(address{0xD005}, address{0x5}), unmapped_read);
+  EXPECT_EQ(dev.read(address{0xD004}, address{0x4}), unmapped_read);
+  EXPECT_EQ(dev.write(address{0xD004}, address{0x4}, std::byte{0x01}), write_status::FAILED);
+  EXPECT_EQ(dev.read(address{0xD00F}, address{0xF}), unmapped_read);
+  EXPECT_EQ(dev.write(address{0xD00F}, address{0xF}, std::byte{0x01}), write_status::FAILED);
+}
+
+TEST(register_map, stability_follows_effects) {
+  const auto dev = device{serial{}};
+  EXPECT_EQ(dev.stable_until(address{0x0}, 10), 10);
+  EXPECT_EQ(dev.stable_until(address{0x2}, 10), 110);
+  EXPECT_EQ(dev.stable_until(address{0x3}, 10), std::numeric_limits<std::uint64_t>::max());
+
+  auto os = std::ostringstream{};
+  os << register_effect::VOLA;
+  EXPECT_EQ(os.str(), "VOLA");
+}
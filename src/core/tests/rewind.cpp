@@ -0,0 +1,117 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+#include "rewind.hpp"
+
+using namespace erelic;
+
+namespace {
+// Executes 3-cycle "instructions" that mix the cycle count into an accumulator.
+struct machine_mock {
+  std::uint64_t cycle = 0;
+  std::uint64_t acc = 1;
+
+  [[nodiscard]] auto cycles() const noexcept -> std::uint64_t { return cycle; }
+
+  void step() {
+    acc = acc * 6364136223846793005ULL + cycle;
+    cycle += 3;
+  }
+
+  void run_until(std::uint64_t target) {
+    while (cycle < target) {
+      step();
+    }
+  }
+
+  void save_state(std::ostream &os) const { os << cycle << ' ' << acc << ' '; }
+  void load_state(std::istream &is) { is >> cycle >> acc; }
+};
+
+static_assert(rewindable_machine<machine_mock>);
+
+auto run_fresh(std::uint64_t target) -> machine_mock {
+  auto m = machine_mock{};
+  m.run_until(target);
+  return m;
+}
+}; // namespace
+
+TEST(rewind, seek_reexecutes_to_exact_state) {
+  auto buffer = rewind_buffer<machine_mock>{8, 64, 100};
+  auto m = machine_mock{};
+  buffer.record(m);
+  while (m.cycles() < 700) {
+    m.step();
+    buffer.record(m);
+  }
+
+  for (const auto target : {0ULL, 150ULL, 301ULL, 450ULL, 699ULL}) {
+    SCOPED_TRACE(target);
+    ASSERT_TRUE(buffer.seek(m, target));
+    const auto expected = run_fresh(target);
+    EXPECT_EQ(m.cycle, expected.cycle);
+    EXPECT_EQ(m.acc, expected.acc);
+  }
+}
+
+TEST(rewind, ring_drops_oldest_snapshots) {
+  auto buffer = rewind_buffer<machine_mock>{4, 64, 100};
+  auto m = machine_mock{};
+  buffer.record(m);
+  while (m.cycles() < 1000) {
+    m.step();
+    buffer.record(m);
+  }
+
+  EXPECT_EQ(buffer.size(), buffer.capacity());
+  ASSERT_TRUE(buffer.oldest_cycle().has_value());
+  EXPECT_GE(*buffer.oldest_cycle(), 600U);
+
+  const auto before = m;
+  EXPECT_FALSE(buffer.seek(m, 100));
+  EXPECT_EQ(m.cycle, before.cycle);
+  EXPECT_EQ(m.acc, before.acc);
+}
+
+TEST(rewind, seek_discards_newer_history) {
+  auto buffer = rewind_buffer<machine_mock>{8, 64, 100};
+  auto m = machine_mock{};
+  buffer.record(m);
+  while (m.cycles() < 700) {
+    m.step();
+    buffer.record(m);
+  }
+
+  ASSERT_TRUE(buffer.seek(m, 250));
+  EXPECT_EQ(buffer.size(), 3);
+
+  while (m.cycles() < 500) {
+    m.step();
+    buffer.record(m);
+  }
+  ASSERT_TRUE(buffer.seek(m, 420));
+  EXPECT_EQ(m.acc, run_fresh(420).acc);
+}
+
+TEST(rewind, fixed_memory_budget) {
+  auto buffer = rewind_buffer<machine_mock>{16, 32, 10};
+  EXPECT_EQ(buffer.memory_budget(), 16 * 32);
+
+  auto tiny = rewind_buffer<machine_mock>{2, 4, 10};
+  auto m = run_fresh(1000);
+  EXPECT_THROW(tiny.record(m), std::length_error);
+  EXPECT_THROW((rewind_buffer<machine_mock>{0, 4, 10}), std::invalid_argument);
+  EXPECT_THROW((rewind_buffer<machine_mock>{4, 0, 10}), std::invalid_argument);
+  EXPECT_THROW((rewind_buffer<machine_mock>{4, 4, 0}), std::invalid_argument);
+  EXPECT_THROW((rewind_buffer<machine_mock>{std::numeric_limits<std::size_t>::max() / 2, 4, 10}), std::length_error);
+}
@@ -0,0 +1,211 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "runahead.hpp"
+#include "snapshot.hpp"
+
+using namespace erelic;
+
+namespace {
+// The program reacts to input one frame late; the presented value exposes which frame was shown.
+struct machine_mock {
+  std::uint64_t frame = 0;
+  std::uint64_t input = 0;
+  std::uint64_t latched = 0;
+  std::uint64_t acc = 0;
+
+  std::vector<std::uint64_t> *presented = nullptr;
+  std::size_t *frames_run = nullptr;
+
+  void run_frame(bool present) {
+    acc = acc * 31 + latched;
+    latched = input;
+    ++frame;
+    ++*frames_run;
+    if (present) {
+      presented->push_back(acc);
+    }
+  }
+
+  void save_state(std::ostream &os) const { os << frame << ' ' << latched << ' ' << acc << ' '; }
+  void load_state(std::istream &is) { is >> frame >> latched >> acc; }
+};
+
+static_assert(frame_machine<machine_mock>);
+
+// Same program keeping a history of the accumulator in memory, snapshotted as a region.
+struct region_mock {
+  machine_mock core;
+  std::array<std::byte, 16> memory{};
+
+  void run_frame(bool present) {
+    core.run_frame(present);
+    memory[core.frame % memory.size()] = static_cast<std::byte>(core.acc);
+  }
+
+  [[nodiscard]] auto state_regions() -> std::array<std::span<std::byte>, 1> { return {memory}; }
+  void save_register_state(std::ostream &os) const { core.save_state(os); }
+  void load_register_state(std::istream &is) { core.load_state(is); }
+};
+
+static_assert(frame_machine<region_mock>);
+static_assert(!snapshottable<region_mock>);
+
+auto inputs() -> std::vector<std::uint64_t> { return {0, 0, 5, 5, 0, 7, 7, 7, 1, 0, 0, 2}; }
+
+// Runs the inputs through `run_ahead` and through restore-then-advance, telling `run_ahead` about input changes only
+// if `report_changes`, and compares the presented frames and the real state.
+void expect_matches_reference(std::size_t frames_ahead, bool report_changes, std::size_t expected_runs) {
+  auto actual = std::vector<std::uint64_t>{};
+  auto actual_runs = std::size_t{0};
+  auto m = machine_mock{.presented = &actual, .frames_run = &actual_runs};
+  auto ra = run_ahead<machine_mock>{frames_ahead, 128};
+
+  auto expected = std::vector<std::uint64_t>{};
+  auto reference_runs = std::size_t{0};
+  auto reference = machine_mock{.presented = &expected, .frames_run = &reference_runs};
+  auto snapshot = state_snapshot{128};
+
+  auto previous = std::optional<std::uint64_t>{};
+  for (const auto input : inputs()) {
+    m.input = input;
+    ra.run_frame(m, !report_changes || previous != input);
+    previous = input;
+
+    reference.input = input;
+    snapshot.capture(reference);
+    for (auto i = std::size_t{1}; i < frames_ahead; ++i) {
+      reference.run_frame(false);
+    }
+    reference.run_frame(true);
+    snapshot.restore(reference);
+    reference.run_frame(false);
+
+    EXPECT_EQ(m.frame, reference.frame + frames_ahead - 1);
+  }
+  EXPECT_EQ(actual, expected);
+  EXPECT_EQ(actual_runs, expected_runs);
+
+  ra.sync(m);
+  EXPECT_EQ(m.frame, reference.frame);
+  EXPECT_EQ(m.latched, reference.latched);
+  EXPECT_EQ(m.acc, reference.acc);
+}
+
+auto changes() -> std::size_t {
+  auto count = std::size_t{0};
+  auto previous = std::optional<std::uint64_t>{};
+  for (const auto input : inputs()) {
+    count += previous != input ? 1 : 0;
+    previous = input;
+  }
+  return count;
+}
+}; // namespace
+
+TEST(runahead, matches_restore_then_advance) {
+  expect_matches_reference(3, false, inputs().size() * 3);
+}
+
+TEST(runahead, held_input_runs_one_frame) {
+  expect_matches_reference(3, true, changes() * 3 + (inputs().size() - changes()));
+  expect_matches_reference(2, true, changes() * 2 + (inputs().size() - changes()));
+}
+
+TEST(runahead, two_frames_cost_two_emulated_frames) {
+  auto presented = std::vector<std::uint64_t>{};
+  auto runs = std::size_t{0};
+  auto m = machine_mock{.presented = &presented, .frames_run = &runs};
+  auto ra = run_ahead<machine_mock>{2, 128};
+
+  for (const auto input : inputs()) {
+    m.input = input;
+    ra.run_frame(m);
+  }
+  EXPECT_EQ(runs, 2 * inputs().size());
+  EXPECT_EQ(presented.size(), inputs().size());
+  EXPECT_EQ(m.frame, inputs().size() + 1);
+  ra.sync(m);
+  EXPECT_EQ(m.frame, inputs().size());
+}
+
+TEST(runahead, disabled_runs_plain_frames) {
+  auto presented = std::vector<std::uint64_t>{};
+  auto runs = std::size_t{0};
+  auto m = machine_mock{.presented = &presented, .frames_run = &runs};
+  auto ra = run_ahead<machine_mock>{0, 128};
+
+  ra.run_frame(m);
+  ra.set_frames_ahead(1);
+  ra.run_frame(m);
+  EXPECT_EQ(runs, 2);
+  EXPECT_EQ(presented.size(), 2);
+}
+
+TEST(runahead, changing_frames_ahead_restores_real_state) {
+  auto presented = std::vector<std::uint64_t>{};
+  auto runs = std::size_t{0};
+  auto m = machine_mock{.presented = &presented, .frames_run = &runs};
+  auto ra = run_ahead<machine_mock>{3, 128};
+
+  ra.run_frame(m);
+  ra.run_frame(m, false);
+  ra.set_frames_ahead(2);
+  ra.run_frame(m, false);
+  EXPECT_EQ(m.frame, 4);
+  ra.set_frames_ahead(0);
+  ra.run_frame(m, false);
+  EXPECT_EQ(m.frame, 4);
+  EXPECT_EQ(runs, 3 + 1 + 2 + 1);
+}
+
+TEST(runahead, snapshots_regions) {
+  auto presented = std::vector<std::uint64_t>{};
+  auto runs = std::size_t{0};
+  auto m = region_mock{.core = {.presented = &presented, .frames_run = &runs}};
+  auto ra = run_ahead<region_mock>{3, 64};
+
+  auto expected = std::vector<std::uint64_t>{};
+  auto reference_runs = std::size_t{0};
+  auto reference = region_mock{.core = {.presented = &expected, .frames_run = &reference_runs}};
+
+  auto previous = std::optional<std::uint64_t>{};
+  for (const auto input : inputs()) {
+    m.core.input = input;
+    ra.run_frame(m, previous != input);
+    previous = input;
+    reference.core.input = input;
+    reference.run_frame(false);
+  }
+  ra.sync(m);
+  EXPECT_EQ(m.core.frame, reference.core.frame);
+  EXPECT_EQ(m.core.acc, reference.core.acc);
+  EXPECT_EQ(m.memory, reference.memory);
+}
+
+TEST(runahead, snapshot_rejects_oversized_state) {
+  auto runs = std::size_t{0};
+  auto presented = std::vector<std::uint64_t>{};
+  const auto m = machine_mock{.frame = 123456789, .presented = &presented, .frames_run = &runs};
+  auto snapshot = state_snapshot{4};
+  EXPECT_THROW(snapshot.capture(m), std::length_error);
+
+  auto r = region_mock{.core = {.presented = &presented, .frames_run = &runs}};
+  auto small = state_snapshot{8};
+  EXPECT_THROW(small.capture(r), std::length_error);
+  auto regions_only = state_snapshot{16};
+  EXPECT_THROW(regions_only.capture(r), std::length_error);
+}
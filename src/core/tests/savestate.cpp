@@ -0,0 +1,251 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <istream>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <span>
+#include <spanstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+#include "registers.hpp"
+#include "savestate.hpp"
+
+using namespace erelic;
+
+namespace {
+// Heap allocations of the whole test program, counted around the calls under test.
+auto allocations = std::atomic<std::size_t>{0};
+}; // namespace
+
+auto operator new(std::size_t size) -> void * {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto *block = std::malloc(size == 0 ? 1 : size)) {
+    return block;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *block) noexcept { std::free(block); }
+
+void operator delete(void *block, std::size_t /*unused*/) noexcept { std::free(block); }
+
+namespace {
+struct ram_mock {
+  std::array<std::byte, 0x400> cells{};
+
+  [[nodiscard]] auto read(address /*unused*/, address r) const noexcept -> std::byte { return cells[r.raw]; }
+  [[nodiscard]] auto write(address /*unused*/, address r, std::byte v) noexcept -> write_status {
+    cells[r.raw] = v;
+    return write_status::WRITTEN;
+  }
+  [[nodiscard]] auto memory() noexcept -> std::span<std::byte> { return cells; }
+};
+
+// Memory-mapped I/O register whose accesses have side effects, counted in `accesses` outside the device state.
+struct counter_mock {
+  std::byte counter{0};
+  std::size_t *accesses = nullptr;
+
+  [[nodiscard]] auto read(address /*unused*/, address /*unused*/) const noexcept -> std::byte {
+    ++*accesses;
+    return counter;
+  }
+  [[nodiscard]] auto write(address /*unused*/, address /*unused*/, std::byte /*unused*/) noexcept -> write_status {
+    ++*accesses;
+    counter = std::byte{static_cast<unsigned char>(std::to_integer<unsigned>(counter) + 1)};
+    return write_status::IGNORED;
+  }
+
+  void save_state(std::ostream &os) const { os.put(static_cast<char>(counter)); }
+  void load_state(std::istream &is) { counter = static_cast<std::byte>(is.get()); }
+};
+
+static_assert(stateful_device<counter_mock>);
+static_assert(!stateful_device<ram_mock>);
+static_assert(memory_device<ram_mock>);
+
+// Unused when a test does not look at device accesses.
+auto ignored_accesses = std::size_t{0};
+
+auto make_bus(std::size_t &accesses = ignored_accesses) -> bus {
+  auto b = bus{};
+  b.map(address_range{address{0x0000}, address{0x03FF}}, device{ram_mock{}});
+  b.map(address_range{address{0xD000}, address{0xD000}}, device{counter_mock{.accesses = &accesses}});
+  return b;
+}
+
+// Header, registers, page count, device count and the two length-prefixed device states.
+constexpr auto header_size = 4 + 1 + 1 + 5 + 2 + 2 + 2 + 4 + 4 + 1;
+constexpr auto memory_pages = 4;
+constexpr auto page_record_size = 1 + 256;
+}; // namespace
+
+TEST(savestate, bus_tracks_dirty_pages_on_written_only) {
+  auto b = make_bus();
+  EXPECT_TRUE(b.dirty_pages().none());
+
+  (void)b.write(address{0x0101}, std::byte{0x01});
+  (void)b.write(address{0xD000}, std::byte{0x01});
+  (void)b.write(address{0x8000}, std::byte{0x01});
+
+  EXPECT_EQ(b.dirty_pages().count(), 1);
+  EXPECT_TRUE(b.dirty_pages().test(0x01));
+
+  b.clear_dirty_pages();
+  EXPECT_TRUE(b.dirty_pages().none());
+}
+
+TEST(savestate, delta_contains_only_dirty_pages) {
+  auto b = make_bus();
+  auto writer = savestate_writer{4};
+  auto stream = std::stringstream{};
+
+  EXPECT_EQ(writer.write(stream, registers{}, b), savestate_kind::KEYFRAME);
+  EXPECT_EQ(stream.str().size(), header_size + memory_pages * page_record_size);
+
+  (void)b.write(address{0x0010}, std::byte{0xAA});
+  (void)b.write(address{0x0320}, std::byte{0xBB});
+
+  auto delta = std::stringstream{};
+  EXPECT_EQ(writer.write(delta, registers{}, b), savestate_kind::DELTA);
+  EXPECT_EQ(delta.str().size(), header_size + 2 * page_record_size);
+  EXPECT_TRUE(b.dirty_pages().none());
+}
+
+TEST(savestate, keyframe_every_n_deltas) {
+  auto b = make_bus();
+  auto writer = savestate_writer{2};
+  auto sink = std::stringstream{};
+
+  EXPECT_EQ(writer.write(sink, registers{}, b), savestate_kind::KEYFRAME);
+  EXPECT_EQ(writer.write(sink, registers{}, b), savestate_kind::DELTA);
+  EXPECT_EQ(writer.write(sink, registers{}, b), savestate_kind::DELTA);
+  EXPECT_EQ(writer.write(sink, registers{}, b), savestate_kind::KEYFRAME);
+
+  writer.restart();
+  EXPECT_EQ(writer.write(sink, registers{}, b), savestate_kind::KEYFRAME);
+}
+
+TEST(savestate, chain_restores_machine) {
+  auto b = make_bus();
+  auto writer = savestate_writer{8};
+  auto chain = std::stringstream{};
+
+  (void)b.write(address{0x0000}, std::byte{0x11});
+  (void)writer.write(chain, registers{}, b);
+
+  (void)b.write(address{0x0201}, std::byte{0x22});
+  (void)b.write(address{0xD000}, std::byte{0x00});
+  const auto regs = registers{
+    .a = std::byte{0x01}, .x = std::byte{0x02}, .y = std::byte{0x03}, .s = std::byte{0xF0}, .p = std::byte{0x81},
+    .pc = address{0xC0DE}};
+  (void)writer.write(chain, regs, b);
+
+  auto restored_bus = make_bus();
+  auto restored_regs = registers{};
+  auto reader = savestate_reader{};
+  EXPECT_EQ(reader.read(chain, restored_regs, restored_bus), savestate_kind::KEYFRAME);
+  EXPECT_EQ(reader.read(chain, restored_regs, restored_bus), savestate_kind::DELTA);
+
+  EXPECT_EQ(restored_regs, regs);
+  EXPECT_EQ(restored_bus.read(address{0x0000}), std::byte{0x11});
+  EXPECT_EQ(restored_bus.read(address{0x0201}), std::byte{0x22});
+  EXPECT_EQ(restored_bus.read(address{0xD000}), std::byte{0x01});
+  EXPECT_TRUE(restored_bus.dirty_pages().none());
+}
+
+TEST(savestate, leaves_memory_mapped_io_to_device_state) {
+  auto accesses = std::size_t{0};
+  auto b = make_bus(accesses);
+  (void)b.write(address{0xD000}, std::byte{0x00});
+  accesses = 0;
+
+  auto state = std::stringstream{};
+  (void)savestate_writer{1}.write(state, registers{}, b);
+  EXPECT_EQ(accesses, 0);
+
+  auto restored_accesses = std::size_t{0};
+  auto restored_bus = make_bus(restored_accesses);
+  auto regs = registers{};
+  (void)savestate_reader{}.read(state, regs, restored_bus);
+  EXPECT_EQ(restored_accesses, 0);
+  EXPECT_EQ(restored_bus.read(address{0xD000}), std::byte{0x01});
+}
+
+TEST(savestate, rejects_malformed_input) {
+  auto b = make_bus();
+  auto regs = registers{};
+
+  auto garbage = std::stringstream{"XXXX"};
+  EXPECT_THROW((void)savestate_reader{}.read(garbage, regs, b), std::runtime_error);
+
+  auto state = std::stringstream{};
+  (void)savestate_writer{1}.write(state, regs, b);
+  auto truncated = std::stringstream{state.str().substr(0, 100)};
+  EXPECT_THROW((void)savestate_reader{}.read(truncated, regs, b), std::runtime_error);
+}
+
+TEST(savestate, malformed_input_leaves_machine_untouched) {
+  auto b = make_bus();
+  (void)b.write(address{0x0010}, std::byte{0xAA});
+  auto state = std::stringstream{};
+  (void)savestate_writer{1}.write(state, registers{.a = std::byte{0x42}}, b);
+
+  auto target = make_bus();
+  auto regs = registers{};
+  auto without_device_state = std::stringstream{state.str().substr(0, state.str().size() - 1)};
+  EXPECT_THROW((void)savestate_reader{}.read(without_device_state, regs, target), std::runtime_error);
+  EXPECT_EQ(target.read(address{0x0010}), std::byte{0x00});
+  EXPECT_EQ(regs, registers{});
+}
+
+TEST(savestate, saving_and_loading_do_not_allocate) {
+  auto b = make_bus();
+  (void)b.write(address{0x0123}, std::byte{0x5A});
+  (void)b.write(address{0xD000}, std::byte{0x00});
+  auto buffer = std::array<char, 0x1000>{};
+  auto writer = savestate_writer{4};
+  auto reader = savestate_reader{};
+  auto target = make_bus();
+  auto regs = registers{};
+
+  const auto probe = allocations.load();
+  (void)std::make_unique<int>(0);
+  ASSERT_GT(allocations.load(), probe);
+
+  // The first state shapes the reader's device buffer.
+  auto warmup = std::ospanstream{std::span{buffer}};
+  (void)writer.write(warmup, registers{}, b);
+  auto warmup_in = std::ispanstream{warmup.span()};
+  (void)reader.read(warmup_in, regs, target);
+
+  for (auto i = 0; i < 3; ++i) {
+    (void)b.write(address{static_cast<address_raw>(0x0100 * i)}, std::byte{0x11});
+    auto os = std::ospanstream{std::span{buffer}};
+    const auto before_save = allocations.load();
+    (void)writer.write(os, registers{.a = std::byte{0x42}}, b);
+    EXPECT_EQ(allocations.load(), before_save);
+
+    auto is = std::ispanstream{os.span()};
+    const auto before_load = allocations.load();
+    (void)reader.read(is, regs, target);
+    EXPECT_EQ(allocations.load(), before_load);
+  }
+  EXPECT_EQ(regs.a, std::byte{0x42});
+  EXPECT_EQ(target.read(address{0x0123}), std::byte{0x5A});
+  EXPECT_EQ(target.read(address{0x0200}), std::byte{0x11});
+  EXPECT_EQ(target.read(address{0xD000}), std::byte{0x01});
+}
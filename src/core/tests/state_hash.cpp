@@ -0,0 +1,157 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+#include "registers.hpp"
+#include "state_hash.hpp"
+
+using namespace erelic;
+
+namespace {
+struct ram_mock {
+  std::vector<std::byte> cells = std::vector<std::byte>(0x8000);
+
+  [[nodiscard]] auto read(address /*unused*/, address r) const noexcept -> std::byte { return cells[r.raw]; }
+  [[nodiscard]] auto write(address /*unused*/, address r, std::byte v) noexcept -> write_status {
+    cells[r.raw] = v;
+    return write_status::WRITTEN;
+  }
+  [[nodiscard]] auto memory() noexcept -> std::span<std::byte> { return cells; }
+};
+
+struct rom_mock {
+  [[nodiscard]] auto read(address /*unused*/, address /*unused*/) const noexcept -> std::byte {
+    return std::byte{0xEA};
+  }
+  [[nodiscard]] auto write(address /*unused*/, address /*unused*/, std::byte /*unused*/) noexcept -> write_status {
+    return write_status::IGNORED;
+  }
+};
+}; // namespace
+
+TEST(state_hash, incremental_matches_full_rehash) {
+  auto hash = std::make_unique<state_hash>();
+  auto rng = std::mt19937{42};
+  for (auto i = 0; i < 10000; ++i) {
+    hash->write(address{static_cast<address_raw>(rng())}, static_cast<std::byte>(rng()));
+  }
+  const auto rehashed = std::make_unique<state_hash>(hash->memory(), hash->cpu());
+  EXPECT_EQ(hash->value(), rehashed->value());
+  EXPECT_EQ(*hash, *rehashed);
+}
+
+TEST(state_hash, undoing_writes_restores_value) {
+  auto hash = std::make_unique<state_hash>();
+  const auto initial = hash->value();
+
+  hash->write(address{0x1234}, std::byte{0x56});
+  EXPECT_NE(hash->value(), initial);
+  hash->write(address{0x1234}, std::byte{0x56});
+  const auto written = hash->value();
+  hash->write(address{0x1234}, std::byte{0x00});
+  EXPECT_EQ(hash->value(), initial);
+  EXPECT_NE(written, initial);
+}
+
+TEST(state_hash, registers_are_part_of_the_state) {
+  auto hash = std::make_unique<state_hash>();
+  const auto initial = hash->value();
+
+  auto cpu = registers{};
+  cpu.pc = address{0xC000};
+  hash->set_registers(cpu);
+  EXPECT_NE(hash->value(), initial);
+  EXPECT_EQ(hash->cpu(), cpu);
+
+  hash->set_registers(registers{});
+  EXPECT_EQ(hash->value(), initial);
+}
+
+TEST(state_hash, register_and_memory_keys_differ) {
+  auto a = std::make_unique<state_hash>();
+  auto b = std::make_unique<state_hash>();
+  a->write(address{0x0000}, std::byte{0x01});
+  auto cpu = registers{};
+  cpu.a = std::byte{0x01};
+  b->set_registers(cpu);
+  EXPECT_NE(a->value(), b->value());
+  EXPECT_FALSE(*a == *b);
+}
+
+TEST(state_hash, bus_feeds_written_writes) {
+  auto b = bus{};
+  b.map(address_range{address{0x0000}, address{0x7FFF}}, device{ram_mock{}});
+  b.map(address_range{address{0x8000}, address{0xFFFF}}, device{rom_mock{}});
+
+  auto hash = std::make_unique<state_hash>();
+  EXPECT_TRUE(b.track_state(hash.get()));
+  const auto initial = hash->value();
+
+  EXPECT_EQ(b.write(address{0x8000}, std::byte{0x42}), write_status::IGNORED);
+  EXPECT_EQ(hash->value(), initial);
+
+  EXPECT_EQ(b.write(address{0x0200}, std::byte{0x42}), write_status::WRITTEN);
+  EXPECT_EQ(hash->memory()[0x0200], std::byte{0x42});
+  EXPECT_NE(hash->value(), initial);
+
+  EXPECT_TRUE(b.track_state(nullptr));
+  EXPECT_EQ(b.write(address{0x0201}, std::byte{0x42}), write_status::WRITTEN);
+  EXPECT_EQ(hash->memory()[0x0201], std::byte{0x00});
+}
+
+TEST(state_hash, bound_pages_and_tracking_exclude_each_other) {
+  auto b = bus{};
+  b.map(address_range{address{0x0000}, address{0x7FFF}}, device{ram_mock{}});
+  auto hash = std::make_unique<state_hash>();
+
+  EXPECT_TRUE(b.track_state(hash.get()));
+  EXPECT_TRUE(b.bind_page(0x00).empty());
+  EXPECT_TRUE(b.track_state(nullptr));
+
+  EXPECT_FALSE(b.bind_page(0x00).empty());
+  EXPECT_FALSE(b.track_state(hash.get()));
+}
+
+TEST(state_hash, register_updates_match_full_rehash) {
+  auto hash = std::make_unique<state_hash>();
+  auto rng = std::mt19937{7};
+  for (auto i = 0; i < 1000; ++i) {
+    auto cpu = hash->cpu();
+    cpu.a = static_cast<std::byte>(rng() % 4);
+    cpu.pc = address{static_cast<address_raw>(rng() % 3)};
+    hash->set_registers(cpu);
+  }
+  EXPECT_EQ(hash->value(), std::make_unique<state_hash>(hash->memory(), hash->cpu())->value());
+}
+
+TEST(state_set, detects_revisited_states) {
+  for (const auto exact : {false, true}) {
+    auto seen = state_set{exact};
+    auto hash = std::make_unique<state_hash>();
+
+    EXPECT_FALSE(seen.insert(*hash));
+    hash->write(address{0x0010}, std::byte{0x01});
+    EXPECT_FALSE(seen.contains(*hash));
+    EXPECT_FALSE(seen.insert(*hash));
+    hash->write(address{0x0010}, std::byte{0x00});
+    EXPECT_TRUE(seen.contains(*hash));
+    EXPECT_TRUE(seen.insert(*hash));
+    EXPECT_EQ(seen.size(), 2U);
+
+    seen.clear();
+    EXPECT_EQ(seen.size(), 0U);
+    EXPECT_FALSE(seen.contains(*hash));
+  }
+}
@@ -0,0 +1,76 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+#include "static_bus.hpp"
+
+using namespace erelic;
+
+namespace {
+struct ram_mock {
+  std::array<std::byte, 0x100> cells{};
+
+  [[nodiscard]] constexpr auto read(address /*unused*/, address r) const noexcept -> std::byte {
+    return cells[r.raw];
+  }
+  [[nodiscard]] constexpr auto write(address /*unused*/, address r, std::byte v) noexcept -> write_status {
+    cells[r.raw] = v;
+    return write_status::WRITTEN;
+  }
+};
+
+struct relative_echo {
+  [[nodiscard]] static constexpr auto read(address /*unused*/, address r) noexcept -> std::byte {
+    return std::byte{static_cast<unsigned char>(r.raw)};
+  }
+  [[nodiscard]] static constexpr auto write(address /*unused*/, address /*unused*/, std::byte /*unused*/) noexcept
+    -> write_status {
+    return write_status::IGNORED;
+  }
+};
+
+using zero_page = mapping<address_range{address{0x0000}, address{0x00FF}}, ram_mock>;
+using echo_page = mapping<address_range{address{0x8000}, address{0x80FF}}, relative_echo>;
+using test_bus = static_bus<zero_page, echo_page>;
+
+static_assert(io_bus<test_bus>);
+static_assert(test_bus{}.read(address{0x8042}) == std::byte{0x42});
+static_assert(test_bus{}.read(address{0x4000}) == unmapped_read);
+static_assert([] {
+  auto b = test_bus{};
+  (void)b.write(address{0x0010}, std::byte{0x5A});
+  return b.read(address{0x0010});
+}() == std::byte{0x5A});
+
+template <typename... Mappings>
+concept valid_static_bus = requires { typename static_bus<Mappings...>; } && requires { static_bus<Mappings...>{}; };
+
+using overlapping_page = mapping<address_range{address{0x00F0}, address{0x01FF}}, ram_mock>;
+static_assert(valid_static_bus<zero_page, echo_page>);
+static_assert(!valid_static_bus<zero_page, overlapping_page>);
+}; // namespace
+
+TEST(static_bus, routes_to_mapped_device_with_relative_address) {
+  auto b = test_bus{};
+
+  EXPECT_EQ(b.write(address{0x0010}, std::byte{0x5A}), write_status::WRITTEN);
+  EXPECT_EQ(b.read(address{0x0010}), std::byte{0x5A});
+  EXPECT_EQ(b.get<0>().cells[0x10], std::byte{0x5A});
+  EXPECT_EQ(b.read(address{0x8042}), std::byte{0x42});
+  EXPECT_EQ(b.write(address{0x8042}, std::byte{0x01}), write_status::IGNORED);
+}
+
+TEST(static_bus, unmapped_access) {
+  auto b = test_bus{};
+
+  EXPECT_EQ(b.read(address{0x1234}), unmapped_read);
+  EXPECT_EQ(b.write(address{0x1234}, std::byte{0x01}), write_status::FAILED);
+}
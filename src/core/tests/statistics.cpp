@@ -0,0 +1,111 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "device.hpp"
+#include "statistics.hpp"
+
+using namespace erelic;
+
+namespace {
+struct ram_mock {
+  std::array<std::byte, 0x100> cells{};
+
+  [[nodiscard]] auto read(address /*unused*/, address r) const noexcept -> std::byte { return cells[r.raw]; }
+  [[nodiscard]] auto write(address /*unused*/, address r, std::byte v) noexcept -> write_status {
+    cells[r.raw] = v;
+    return write_status::WRITTEN;
+  }
+};
+
+struct rom_mock {
+  [[nodiscard]] static auto read(address /*unused*/, address /*unused*/) noexcept -> std::byte { return std::byte{0}; }
+  [[nodiscard]] static auto write(address /*unused*/, address /*unused*/, std::byte /*unused*/) noexcept
+    -> write_status {
+    return write_status::IGNORED;
+  }
+};
+}; // namespace
+
+TEST(statistics, bus_counts_accesses_per_device) {
+  auto b = bus{};
+  b.map(address_range{address{0x0000}, address{0x00FF}}, device{ram_mock{}});
+  b.map(address_range{address{0xFF00}, address{0xFFFF}}, device{rom_mock{}});
+
+  (void)b.read(address{0x0010});
+  EXPECT_EQ(b.access_counts()[0].reads, 0);
+
+  b.count_accesses(true);
+  (void)b.read(address{0x0010});
+  (void)b.read(address{0xFFFC});
+  (void)b.read(address{0x1234});
+  (void)b.write(address{0x0010}, std::byte{1});
+  (void)b.write(address{0xFFFC}, std::byte{1});
+  (void)b.write(address{0xFFFD}, std::byte{1});
+  (void)b.write(address{0x1234}, std::byte{1});
+
+  const auto counts = b.access_counts();
+  ASSERT_EQ(counts.size(), 3);
+  EXPECT_EQ(counts[0].reads, 1);
+  EXPECT_EQ(counts[0].writes_with(write_status::WRITTEN), 1);
+  EXPECT_EQ(counts[1].reads, 1);
+  EXPECT_EQ(counts[1].writes_with(write_status::IGNORED), 2);
+  EXPECT_EQ(counts[2].reads, 1);
+  EXPECT_EQ(counts[2].writes_with(write_status::FAILED), 1);
+
+  b.reset_access_counts();
+  EXPECT_EQ(b.access_counts()[1], device_counts{});
+}
+
+TEST(statistics, snapshot_reflects_last_publish) {
+  auto stats = statistics{2};
+  EXPECT_EQ(stats.snapshot().generation, 0);
+
+  auto devices = std::array<device_counts, 3>{};
+  devices[0].reads = 5;
+  devices[1].count(write_status::IGNORED);
+  devices[2].reads = 9;
+  stats.publish(core_counts{.cycles = 700, .instructions = 200, .interrupts = 1}, devices);
+
+  const auto snap = stats.snapshot();
+  EXPECT_EQ(snap.generation, 1);
+  EXPECT_EQ(snap.core, (core_counts{700, 200, 1}));
+  ASSERT_EQ(snap.devices.size(), 2);
+  EXPECT_EQ(snap.devices[0], devices[0]);
+  EXPECT_EQ(snap.devices[1], devices[1]);
+}
+
+TEST(statistics, monitor_sees_consistent_snapshots) {
+  auto stats = statistics{1};
+  auto done = std::atomic<bool>{false};
+
+  auto monitor = std::thread{[&] {
+    while (!done.load(std::memory_order_relaxed)) {
+      const auto snap = stats.snapshot();
+      ASSERT_EQ(snap.core.cycles, snap.core.instructions * 3);
+      ASSERT_EQ(snap.devices[0].reads, snap.core.instructions);
+      ASSERT_EQ(snap.core.instructions, snap.generation);
+    }
+  }};
+
+  auto core = core_counts{};
+  auto devices = std::array<device_counts, 1>{};
+  for (auto i = 0; i < 100'000; ++i) {
+    core.cycles += 3;
+    ++core.instructions;
+    ++devices[0].reads;
+    stats.publish(core, devices);
+  }
+  done = true;
+  monitor.join();
+}
@@ -0,0 +1,137 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "address.hpp"
+#include "device.hpp"
+#include "spsc_queue.hpp"
+#include "threaded_device.hpp"
+
+using namespace erelic;
+
+namespace {
+struct write_record {
+  std::uint64_t cycle;
+  address_raw relative;
+  std::byte value;
+
+  auto operator==(const write_record &o) const noexcept -> bool = default;
+};
+
+// Register 0 is a status register whose value depends on how many writes the device has processed, register 1 a
+// counter holding the low byte of the device's cycle.
+struct synth_mock {
+  std::uint64_t now = 0;
+  std::vector<write_record> log;
+
+  [[nodiscard]] static auto synchronizing_read(address r) noexcept -> bool { return r.raw <= 1; }
+
+  void advance_to(std::uint64_t cycle) noexcept { now = cycle; }
+
+  [[nodiscard]] auto read(address /*unused*/, address r) const noexcept -> std::byte {
+    return std::byte{static_cast<unsigned char>(r.raw == 0 ? log.size() : now)};
+  }
+  [[nodiscard]] auto write(address /*unused*/, address r, std::byte v) noexcept -> write_status {
+    log.push_back({now, r.raw, v});
+    return write_status::WRITTEN;
+  }
+
+  void save_state(std::ostream &os) const { os << log.size() << ' '; }
+  void load_state(std::istream &is) {
+    auto size = std::size_t{0};
+    is >> size;
+    log.resize(size, write_record{});
+  }
+};
+
+using threaded_synth = threaded_device<synth_mock, 16, 8>;
+
+static_assert(io_device<threaded_synth>);
+static_assert(stateful_device<threaded_synth>);
+static_assert(timed_device<synth_mock>);
+static_assert(synchronizing_device<synth_mock>);
+}; // namespace
+
+TEST(spsc_queue, preserves_order_across_threads) {
+  constexpr auto count = std::uint32_t{100'000};
+  auto queue = spsc_queue<std::uint32_t, 64>{};
+
+  auto consumer = std::thread{[&] {
+    for (auto expected = std::uint32_t{0}; expected < count;) {
+      if (const auto value = queue.try_pop()) {
+        ASSERT_EQ(*value, expected);
+        ++expected;
+      }
+    }
+  }};
+  for (auto value = std::uint32_t{0}; value < count;) {
+    if (queue.try_push(value)) {
+      ++value;
+    }
+  }
+  consumer.join();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(spsc_queue, reports_full_and_empty) {
+  auto queue = spsc_queue<int, 2>{};
+  EXPECT_FALSE(queue.try_pop().has_value());
+  EXPECT_TRUE(queue.try_push(1));
+  EXPECT_TRUE(queue.try_push(2));
+  EXPECT_FALSE(queue.try_push(3));
+  EXPECT_EQ(queue.try_pop(), std::optional{1});
+}
+
+TEST(threaded_device, applies_cycle_stamped_writes_in_order) {
+  auto clock = std::uint64_t{0};
+  auto synth = std::make_shared<threaded_synth>(clock);
+  auto dev = device{synth};
+
+  auto expected = std::vector<write_record>{};
+  for (auto i = 0U; i < 200; ++i) {
+    clock = i * 4;
+    const auto reg = static_cast<address_raw>(1 + i % 15);
+    const auto value = std::byte{static_cast<unsigned char>(i)};
+    EXPECT_EQ(dev.write(address{static_cast<address_raw>(0xD400 + reg)}, address{reg}, value), write_status::WRITTEN);
+    expected.push_back({clock, reg, value});
+  }
+
+  EXPECT_EQ(dev.read(address{0xD400}, address{0}), std::byte{200});
+
+  auto state = std::stringstream{};
+  dev.save_state(state);
+  EXPECT_EQ(state.str(), "200 ");
+}
+
+TEST(threaded_device, mirrored_reads_return_last_written_value) {
+  auto clock = std::uint64_t{0};
+  auto synth = threaded_synth{clock};
+
+  EXPECT_EQ(synth.read(address{0xD405}, address{5}), std::byte{0});
+  (void)synth.write(address{0xD405}, address{5}, std::byte{0x42});
+  EXPECT_EQ(synth.read(address{0xD405}, address{5}), std::byte{0x42});
+  EXPECT_EQ(synth.write(address{0xD4FF}, address{0xFF}, std::byte{0x42}), write_status::FAILED);
+}
+
+TEST(threaded_device, synchronizing_reads_see_the_current_cycle) {
+  auto clock = std::uint64_t{10};
+  auto synth = threaded_synth{clock};
+
+  (void)synth.write(address{0xD402}, address{2}, std::byte{0x01});
+  clock = 90;
+  EXPECT_EQ(synth.read(address{0xD401}, address{1}), std::byte{90});
+  clock = 120;
+  EXPECT_EQ(synth.read(address{0xD401}, address{1}), std::byte{120});
+}
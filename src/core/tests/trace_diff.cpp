@@ -0,0 +1,171 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "trace_diff.hpp"
+
+using namespace erelic;
+
+namespace {
+constexpr auto nestest_line = std::string_view{
+  "C000  4C F5 C5  JMP $C5F5                       A:00 X:00 Y:00 P:24 SP:FD PPU:  0, 21 CYC:7"};
+
+auto record(std::uint16_t pc, std::uint8_t a, std::uint64_t cycle) -> trace_record {
+  return {.pc = pc, .opcode = std::byte{0xEA}, .a = std::byte{a}, .p = std::byte{0x24}, .s = std::byte{0xFD},
+          .cycle = cycle};
+}
+
+auto text_line(const trace_record &r) -> std::string {
+  return std::format("{:04X}  {:02X}        NOP                             A:{:02X} X:00 Y:00 P:24 SP:FD CYC:{}\n",
+                     r.pc, std::to_integer<unsigned>(r.opcode), std::to_integer<unsigned>(r.a), r.cycle);
+}
+
+auto binary_trace(const std::vector<trace_record> &records) -> std::string {
+  auto os = std::ostringstream{};
+  write_trace_header(os);
+  for (const auto &r : records) {
+    write_trace_record(os, r);
+  }
+  return os.str();
+}
+
+auto program(std::size_t count) -> std::vector<trace_record> {
+  auto records = std::vector<trace_record>{};
+  for (auto i = std::size_t{0}; i < count; ++i) {
+    records.push_back(record(static_cast<std::uint16_t>(0xC000 + i), static_cast<std::uint8_t>(i), 7 + 2 * i));
+  }
+  return records;
+}
+
+auto text_trace(const std::vector<trace_record> &records) -> std::string {
+  auto text = std::string{};
+  for (const auto &r : records) {
+    text += text_line(r);
+  }
+  return text;
+}
+
+auto diff(const std::string &binary, const std::string &text) {
+  return diff_traces(std::as_bytes(std::span{binary}), text, 2);
+}
+}; // namespace
+
+TEST(trace_diff, encode_round_trip) {
+  const auto r = trace_record{.pc = 0xC123, .opcode = std::byte{0x4C}, .a = std::byte{0x01}, .x = std::byte{0x02},
+                              .y = std::byte{0x03}, .p = std::byte{0x24}, .s = std::byte{0xFD}, .cycle = 0x0102030405};
+  const auto bytes = encode(r);
+  EXPECT_EQ(bytes[0], std::byte{0x23});
+  EXPECT_EQ(bytes[1], std::byte{0xC1});
+  EXPECT_EQ(bytes[8], std::byte{0x05});
+  EXPECT_EQ(decode(bytes), r);
+}
+
+TEST(trace_diff, parses_nestest_lines) {
+  const auto parsed = parse_trace_line(nestest_line);
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(parsed->record, (trace_record{.pc = 0xC000, .opcode = std::byte{0x4C}, .p = std::byte{0x24},
+                                          .s = std::byte{0xFD}, .cycle = 7}));
+  EXPECT_EQ(parsed->fields, 0xFF);
+
+  const auto partial = parse_trace_line("C5F5  A2 00     LDX #$00   A:00 X:00 Y:00 P:24 SP:FD");
+  ASSERT_TRUE(partial);
+  EXPECT_EQ(partial->fields & field_bit(trace_field::CYCL), 0);
+  EXPECT_NE(partial->fields & field_bit(trace_field::REGS), 0);
+
+  EXPECT_FALSE(parse_trace_line(""));
+  EXPECT_FALSE(parse_trace_line("nestest log"));
+  EXPECT_FALSE(parse_trace_line("C0G0  4C"));
+}
+
+TEST(trace_diff, first_mismatch_honours_mask) {
+  auto actual = std::vector<std::byte>(1000 * trace_record_size);
+  auto expected = actual;
+  auto mask = std::vector<std::byte>(actual.size(), std::byte{0xFF});
+  expected[100 * trace_record_size + 3] = std::byte{0x01};
+  mask[100 * trace_record_size + 3] = std::byte{0x00};
+  expected[777 * trace_record_size + 9] = std::byte{0x01};
+
+  EXPECT_EQ(first_mismatch(actual, expected, mask), 777U);
+  EXPECT_EQ(first_mismatch(actual, actual, mask), 1000U);
+}
+
+TEST(trace_diff, agreeing_traces) {
+  const auto records = program(10000);
+  EXPECT_FALSE(diff(binary_trace(records), "header line\n" + text_trace(records)));
+}
+
+TEST(trace_diff, reports_first_divergence_with_context) {
+  const auto records = program(5000);
+  auto reference = records;
+  reference[4500].a = std::byte{0x42};
+  reference[4600].a = std::byte{0x43};
+
+  const auto d = diff(binary_trace(records), text_trace(reference));
+  ASSERT_TRUE(d);
+  EXPECT_EQ(d->index, 4500U);
+  EXPECT_EQ(d->line, 4501U);
+  EXPECT_EQ(d->context, (std::vector{records[4498], records[4499]}));
+  EXPECT_EQ(d->following, (std::vector{records[4501], records[4502]}));
+  EXPECT_EQ(d->actual, records[4500]);
+  EXPECT_EQ(d->expected, reference[4500]);
+
+  auto os = std::ostringstream{};
+  os << *d;
+  EXPECT_TRUE(os.str().starts_with("divergence at record 4500 (reference line 4501), differs in REGA\n"));
+}
+
+TEST(trace_diff, reports_the_trace_that_ends_first) {
+  const auto records = program(10);
+  const auto shorter = std::vector(records.begin(), records.begin() + 7);
+
+  const auto binary_short = diff(binary_trace(shorter), text_trace(records));
+  ASSERT_TRUE(binary_short);
+  EXPECT_EQ(binary_short->index, 7U);
+  EXPECT_FALSE(binary_short->actual);
+  EXPECT_EQ(binary_short->expected, records[7]);
+  EXPECT_TRUE(binary_short->following.empty());
+
+  const auto reference_short = diff(binary_trace(records), text_trace(shorter));
+  ASSERT_TRUE(reference_short);
+  EXPECT_EQ(reference_short->index, 7U);
+  EXPECT_EQ(reference_short->actual, records[7]);
+  EXPECT_FALSE(reference_short->expected);
+  EXPECT_EQ(reference_short->following, (std::vector{records[8], records[9]}));
+}
+
+TEST(trace_diff, rejects_malformed_binary) {
+  EXPECT_THROW((void)diff("not a trace", ""), std::runtime_error);
+  EXPECT_THROW((void)diff(binary_trace({}) + "xyz", ""), std::runtime_error);
+}
+
+TEST(trace_diff, diffs_mapped_files) {
+  const auto dir = std::filesystem::temp_directory_path();
+  const auto binary = dir / "erelic_trace_diff_test.bin";
+  const auto text = dir / "erelic_trace_diff_test.log";
+  const auto records = program(100);
+  std::ofstream{binary, std::ios::binary} << binary_trace(records);
+  std::ofstream{text} << text_trace(records);
+
+  EXPECT_FALSE(diff_trace_files(binary, text));
+  EXPECT_EQ(mapped_file{text}.text(), text_trace(records));
+
+  std::filesystem::remove(binary);
+  std::filesystem::remove(text);
+  EXPECT_THROW((void)mapped_file{text}, std::system_error);
+}
@@ -0,0 +1,154 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+#include "address.hpp"
+#include "device.hpp"
+#include "spsc_queue.hpp"
+
+namespace erelic {
+// Device that wants to catch up to the cycle a write was issued at before the write is applied.
+template <typename T>
+concept timed_device = requires(T dev, std::uint64_t cycle) {
+  { dev.advance_to(cycle) } noexcept;
+};
+
+// Device whose reads of some registers depend on its internal progress and must see every pending write applied.
+template <typename T>
+concept synchronizing_device = requires(address r) {
+  { T::synchronizing_read(r) } noexcept -> std::same_as<bool>;
+};
+
+// Runs a heavy device on its own worker thread. CPU-side writes are stamped with the current cycle of `clock` and
+// pushed into a lock-free queue; reads are answered from a mirror of the last values the CPU wrote, except for
+// registers the device declares `synchronizing_read`, which wait for the worker to drain the queue first and, for a
+// timed device, advance it to the current cycle of `clock` so timers and counters read as of the read itself.
+//
+// Deferred writes always report `write_status::WRITTEN`. The adapter is neither copyable nor movable; map it through
+// `device{std::make_shared<threaded_device<...>>(...)}`.
+template <io_device T, std::size_t Registers, std::size_t QueueCapacity = 1024>
+class threaded_device {
+public:
+  template <typename... Args>
+  explicit threaded_device(const std::uint64_t &clock, Args &&...args)
+      : impl(std::forward<Args>(args)...), clock{&clock}, worker{[this](std::stop_token stop) { run(stop); }} {}
+
+  threaded_device(const threaded_device &) = delete;
+  threaded_device(threaded_device &&) = delete;
+  auto operator=(const threaded_device &) -> threaded_device & = delete;
+  auto operator=(threaded_device &&) -> threaded_device & = delete;
+
+  ~threaded_device() {
+    worker.request_stop();
+    wake();
+  }
+
+  [[nodiscard]] auto read(address absolute, address relative) const noexcept -> std::byte {
+    if (relative.raw >= Registers) {
+      return std::byte{0};
+    }
+    if constexpr (synchronizing_device<T>) {
+      if (T::synchronizing_read(relative)) {
+        drain();
+        if constexpr (timed_device<T>) {
+          impl.advance_to(*clock);
+        }
+        return impl.read(absolute, relative);
+      }
+    }
+    return mirror[relative.raw].load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto write(address absolute, address relative, std::byte value) noexcept -> write_status {
+    if (relative.raw >= Registers) {
+      return write_status::FAILED;
+    }
+    mirror[relative.raw].store(value, std::memory_order_relaxed);
+
+    const auto pending = stamped_write{*clock, absolute.raw, relative.raw, value};
+    while (!queue.try_push(pending)) {
+      std::this_thread::yield();
+    }
+    ++pushed;
+    wake();
+    return write_status::WRITTEN;
+  }
+
+  // Blocks until the worker applied every write issued so far.
+  void drain() const noexcept {
+    for (auto done = applied.load(std::memory_order_acquire); done != pushed;
+         done = applied.load(std::memory_order_acquire)) {
+      applied.wait(done, std::memory_order_acquire);
+    }
+  }
+
+  void save_state(std::ostream &os) const
+    requires stateful_device<T>
+  {
+    drain();
+    impl.save_state(os);
+  }
+
+  void load_state(std::istream &is)
+    requires stateful_device<T>
+  {
+    drain();
+    impl.load_state(is);
+  }
+
+private:
+  struct stamped_write {
+    std::uint64_t cycle = 0;
+    address_raw absolute = 0;
+    address_raw relative = 0;
+    std::byte value{0};
+  };
+
+  void wake() noexcept {
+    wakeups.fetch_add(1, std::memory_order_release);
+    wakeups.notify_one();
+  }
+
+  void run(const std::stop_token &stop) noexcept {
+    while (true) {
+      const auto seen = wakeups.load(std::memory_order_acquire);
+      while (const auto pending = queue.try_pop()) {
+        if constexpr (timed_device<T>) {
+          impl.advance_to(pending->cycle);
+        }
+        (void)impl.write(address{pending->absolute}, address{pending->relative}, pending->value);
+        applied.fetch_add(1, std::memory_order_release);
+        applied.notify_all();
+      }
+      if (stop.stop_requested()) {
+        return;
+      }
+      wakeups.wait(seen, std::memory_order_acquire);
+    }
+  }
+
+private:
+  // Touched by the CPU thread only after `drain`, while the worker is idle; reads may advance it.
+  mutable T impl;
+  const std::uint64_t *clock;
+  std::array<std::atomic<std::byte>, Registers> mirror{};
+  spsc_queue<stamped_write, QueueCapacity> queue;
+  std::uint64_t pushed = 0;
+  mutable std::atomic<std::uint64_t> applied{0};
+  std::atomic<std::uint64_t> wakeups{0};
+  std::jthread worker;
+};
+}; // namespace erelic
@@ -0,0 +1,368 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include "trace_diff.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "address.hpp"
+#include "mapped_file.hpp"
+#include "utility.hpp"
+
+namespace erelic {
+namespace {
+constexpr auto magic = std::array{std::byte{'E'}, std::byte{'R'}, std::byte{'T'}, std::byte{'R'}};
+constexpr auto version = std::byte{1};
+constexpr auto header_size = trace_record_size;
+
+// Records parsed from the reference and compared at once.
+constexpr auto batch_size = std::size_t{4096};
+// Records OR-ed together before looking for the one that differs.
+constexpr auto block_size = std::size_t{64};
+
+constexpr auto all_fields = std::array{
+  trace_field::PCNT, trace_field::OPCD, trace_field::REGA, trace_field::REGX,
+  trace_field::REGY, trace_field::REGP, trace_field::REGS, trace_field::CYCL,
+};
+
+// Bytes of an encoded record holding `f`.
+constexpr auto bytes_of(trace_field f) noexcept -> std::pair<std::size_t, std::size_t> {
+  switch (f) {
+    case trace_field::PCNT: return {0, 2};
+    case trace_field::OPCD: return {2, 1};
+    case trace_field::REGA: return {3, 1};
+    case trace_field::REGX: return {4, 1};
+    case trace_field::REGY: return {5, 1};
+    case trace_field::REGP: return {6, 1};
+    case trace_field::REGS: return {7, 1};
+    case trace_field::CYCL: return {8, 8};
+  }
+  return {0, 0};
+}
+
+constexpr auto make_masks() {
+  auto masks = std::array<encoded_trace_record, 256>{};
+  for (auto fields = 0U; fields < masks.size(); ++fields) {
+    for (const auto f : all_fields) {
+      if ((fields & field_bit(f)) != 0) {
+        const auto [offset, length] = bytes_of(f);
+        std::fill_n(masks[fields].begin() + static_cast<std::ptrdiff_t>(offset), length, std::byte{0xFF});
+      }
+    }
+  }
+  return masks;
+}
+
+constexpr auto masks = make_masks();
+
+auto load_word(std::span<const std::byte> bytes, std::size_t word) noexcept -> std::uint64_t {
+  auto value = std::uint64_t{0};
+  std::memcpy(&value, bytes.subspan(word * sizeof(value), sizeof(value)).data(), sizeof(value));
+  return value;
+}
+
+auto record_at(std::span<const std::byte> records, std::size_t index) noexcept -> trace_record {
+  return decode(records.subspan(index * trace_record_size).first<trace_record_size>());
+}
+
+// Fields of `fields` in which `a` and `b` differ.
+auto differing(const trace_record &a, const trace_record &b, trace_fields fields) noexcept -> trace_fields {
+  const auto ea = encode(a);
+  const auto eb = encode(b);
+  auto result = trace_fields{0};
+  for (const auto f : all_fields) {
+    const auto [offset, length] = bytes_of(f);
+    const auto from = static_cast<std::ptrdiff_t>(offset);
+    const auto till = static_cast<std::ptrdiff_t>(offset + length);
+    if ((fields & field_bit(f)) != 0 && !std::equal(ea.begin() + from, ea.begin() + till, eb.begin() + from)) {
+      result |= field_bit(f);
+    }
+  }
+  return result;
+}
+
+void print_fields(std::ostream &os, trace_fields fields) {
+  for (const auto f : all_fields) {
+    if ((fields & field_bit(f)) != 0) {
+      os << " " << f;
+    }
+  }
+}
+
+template <typename T>
+auto parse_number(std::string_view text, int base) noexcept -> std::optional<T> {
+  auto value = T{0};
+  const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value, base);
+  if (error != std::errc{} || end == text.data()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+// Value after ` <key>` in `line`.
+auto field_value(std::string_view line, std::string_view key, int base, std::size_t digits) noexcept
+  -> std::optional<std::uint64_t> {
+  for (auto at = line.find(key); at != std::string_view::npos; at = line.find(key, at + 1)) {
+    if (at == 0 || line[at - 1] != ' ') {
+      continue;
+    }
+    return parse_number<std::uint64_t>(line.substr(at + key.size(), digits), base);
+  }
+  return std::nullopt;
+}
+}; // namespace
+
+auto operator<<(std::ostream &os, const trace_record &r) -> std::ostream & {
+  os << address{r.pc} << " " << r.opcode << " A:" << r.a << " X:" << r.x << " Y:" << r.y << " P:" << r.p
+     << " S:" << r.s << " CYC:" << r.cycle;
+  return os;
+}
+
+auto operator<<(std::ostream &os, const trace_field &f) -> std::ostream & {
+  switch (f) {
+    case trace_field::PCNT: os << "PCNT"; break;
+    case trace_field::OPCD: os << "OPCD"; break;
+    case trace_field::REGA: os << "REGA"; break;
+    case trace_field::REGX: os << "REGX"; break;
+    case trace_field::REGY: os << "REGY"; break;
+    case trace_field::REGP: os << "REGP"; break;
+    case trace_field::REGS: os << "REGS"; break;
+    case trace_field::CYCL: os << "CYCL"; break;
+  }
+  return os;
+}
+
+auto encode(const trace_record &r) noexcept -> encoded_trace_record {
+  auto bytes = encoded_trace_record{
+    static_cast<std::byte>(r.pc & 0xFFU), static_cast<std::byte>(r.pc >> 8U), r.opcode, r.a, r.x, r.y, r.p, r.s,
+  };
+  for (auto i = std::size_t{0}; i < sizeof(r.cycle); ++i) {
+    bytes[8 + i] = static_cast<std::byte>((r.cycle >> (8U * i)) & 0xFFU);
+  }
+  return bytes;
+}
+
+auto decode(std::span<const std::byte, trace_record_size> bytes) noexcept -> trace_record {
+  auto r = trace_record{
+    .pc = static_cast<address_raw>(std::to_integer<unsigned>(bytes[0]) | (std::to_integer<unsigned>(bytes[1]) << 8U)),
+    .opcode = bytes[2],
+    .a = bytes[3],
+    .x = bytes[4],
+    .y = bytes[5],
+    .p = bytes[6],
+    .s = bytes[7],
+  };
+  for (auto i = std::size_t{0}; i < sizeof(r.cycle); ++i) {
+    r.cycle |= std::to_integer<std::uint64_t>(bytes[8 + i]) << (8U * i);
+  }
+  return r;
+}
+
+void write_trace_header(std::ostream &os) {
+  auto header = std::array<char, header_size>{};
+  std::ranges::transform(magic, header.begin(), [](std::byte b) { return static_cast<char>(b); });
+  header[magic.size()] = static_cast<char>(version);
+  os.write(header.data(), header.size());
+}
+
+void write_trace_record(std::ostream &os, const trace_record &r) {
+  auto bytes = std::array<char, trace_record_size>{};
+  std::ranges::transform(encode(r), bytes.begin(), [](std::byte b) { return static_cast<char>(b); });
+  os.write(bytes.data(), bytes.size());
+}
+
+auto parse_trace_line(std::string_view line) noexcept -> std::optional<parsed_trace_line> {
+  const auto start = line.find_first_not_of(' ');
+  if (start == std::string_view::npos || line.size() < start + 4) {
+    return std::nullopt;
+  }
+  line.remove_prefix(start);
+  const auto hex = [](char c) { return std::isxdigit(static_cast<unsigned char>(c)) != 0; };
+  const auto pc = parse_number<address_raw>(line.substr(0, 4), 16);
+  if (!pc || !std::ranges::all_of(line.substr(0, 4), hex) || (line.size() > 4 && line[4] != ' ')) {
+    return std::nullopt;
+  }
+
+  auto parsed = parsed_trace_line{.record = {.pc = *pc}, .fields = field_bit(trace_field::PCNT)};
+  const auto rest = line.substr(4);
+  if (const auto at = rest.find_first_not_of(' '); at != std::string_view::npos && rest.size() >= at + 2 &&
+                                                     (rest.size() == at + 2 || rest[at + 2] == ' ')) {
+    if (const auto opcode = parse_number<std::uint8_t>(rest.substr(at, 2), 16)) {
+      parsed.record.opcode = std::byte{*opcode};
+      parsed.fields |= field_bit(trace_field::OPCD);
+    }
+  }
+
+  const auto set = [&](std::string_view key, trace_field f, std::byte &target) {
+    if (const auto value = field_value(rest, key, 16, 2)) {
+      target = static_cast<std::byte>(*value);
+      parsed.fields |= field_bit(f);
+    }
+  };
+  set("A:", trace_field::REGA, parsed.record.a);
+  set("X:", trace_field::REGX, parsed.record.x);
+  set("Y:", trace_field::REGY, parsed.record.y);
+  set("P:", trace_field::REGP, parsed.record.p);
+  set("SP:", trace_field::REGS, parsed.record.s);
+  set("S:", trace_field::REGS, parsed.record.s);
+  if (const auto cycle = field_value(rest, "CYC:", 10, 20)) {
+    parsed.record.cycle = *cycle;
+    parsed.fields |= field_bit(trace_field::CYCL);
+  }
+  return parsed;
+}
+
+auto first_mismatch(std::span<const std::byte> actual, std::span<const std::byte> expected,
+                    std::span<const std::byte> mask) noexcept -> std::size_t {
+  constexpr auto words_per_record = trace_record_size / sizeof(std::uint64_t);
+  const auto count = std::min({actual.size(), expected.size(), mask.size()}) / trace_record_size;
+  for (auto from = std::size_t{0}; from < count; from += block_size) {
+    const auto till = std::min(count, from + block_size);
+    auto any = std::uint64_t{0};
+    for (auto word = from * words_per_record; word < till * words_per_record; ++word) {
+      any |= (load_word(actual, word) ^ load_word(expected, word)) & load_word(mask, word);
+    }
+    if (any == 0) {
+      continue;
+    }
+    for (auto record = from; record < till; ++record) {
+      auto diff = std::uint64_t{0};
+      for (auto word = record * words_per_record; word < (record + 1) * words_per_record; ++word) {
+        diff |= (load_word(actual, word) ^ load_word(expected, word)) & load_word(mask, word);
+      }
+      if (diff != 0) {
+        return record;
+      }
+    }
+  }
+  return count;
+}
+
+auto operator<<(std::ostream &os, const trace_divergence &d) -> std::ostream & {
+  os << "divergence at record " << d.index;
+  if (d.line != 0) {
+    os << " (reference line " << d.line << ")";
+  }
+  if (d.actual && d.expected) {
+    os << ", differs in";
+    print_fields(os, differing(*d.actual, *d.expected, d.fields));
+  }
+  os << "\n";
+  for (const auto &r : d.context) {
+    os << "    " << r << "\n";
+  }
+  os << "  - ";
+  if (d.expected) {
+    os << *d.expected;
+  } else {
+    os << "end of reference trace";
+  }
+  os << "\n  + ";
+  if (d.actual) {
+    os << *d.actual;
+  } else {
+    os << "end of binary trace";
+  }
+  for (const auto &r : d.following) {
+    os << "\n    " << r;
+  }
+  return os;
+}
+
+auto diff_traces(std::span<const std::byte> actual, std::string_view reference, std::size_t context)
+  -> std::optional<trace_divergence> {
+  if (actual.size() < header_size || !std::ranges::equal(actual.first(magic.size()), magic)) {
+    throw std::runtime_error("trace_diff: bad magic");
+  }
+  if (actual[magic.size()] != version) {
+    throw std::runtime_error("trace_diff: unsupported version");
+  }
+  const auto records = actual.subspan(header_size);
+  if (records.size() % trace_record_size != 0) {
+    throw std::runtime_error("trace_diff: truncated record");
+  }
+  const auto count = records.size() / trace_record_size;
+
+  const auto diverge = [&](std::size_t index) {
+    auto d = trace_divergence{.index = index};
+    for (auto i = index - std::min(index, context); i < index; ++i) {
+      d.context.push_back(record_at(records, i));
+    }
+    if (index < count) {
+      d.actual = record_at(records, index);
+    }
+    for (auto i = index + 1; i < std::min(count, index + 1 + context); ++i) {
+      d.following.push_back(record_at(records, i));
+    }
+    return d;
+  };
+
+  auto expected = std::vector<std::byte>(batch_size * trace_record_size);
+  auto mask = std::vector<std::byte>(batch_size * trace_record_size);
+  auto lines = std::vector<std::uint64_t>(batch_size);
+  auto fields = std::vector<trace_fields>(batch_size);
+  auto line = std::uint64_t{0};
+  auto index = std::size_t{0};
+  while (!reference.empty()) {
+    auto parsed = std::size_t{0};
+    while (parsed < batch_size && !reference.empty()) {
+      const auto end = std::min(reference.find('\n'), reference.size());
+      const auto text = reference.substr(0, end);
+      reference.remove_prefix(std::min(end + 1, reference.size()));
+      ++line;
+      const auto result = parse_trace_line(text.ends_with('\r') ? text.substr(0, text.size() - 1) : text);
+      if (!result) {
+        continue;
+      }
+      const auto offset = static_cast<std::ptrdiff_t>(parsed * trace_record_size);
+      std::ranges::copy(encode(result->record), expected.begin() + offset);
+      std::ranges::copy(masks[result->fields], mask.begin() + offset);
+      lines[parsed] = line;
+      fields[parsed] = result->fields;
+      ++parsed;
+    }
+
+    const auto available = std::min(parsed, count - index);
+    const auto bytes = available * trace_record_size;
+    const auto at = first_mismatch(records.subspan(index * trace_record_size, bytes),
+                                   std::span<const std::byte>{expected}.first(bytes),
+                                   std::span<const std::byte>{mask}.first(bytes));
+    if (at < parsed) {
+      auto d = diverge(index + at);
+      d.line = lines[at];
+      d.expected = record_at(expected, at);
+      d.fields = fields[at];
+      return d;
+    }
+    index += parsed;
+  }
+
+  if (index < count) {
+    return diverge(index);
+  }
+  return std::nullopt;
+}
+
+auto diff_trace_files(const std::filesystem::path &actual, const std::filesystem::path &reference,
+                      std::size_t context) -> std::optional<trace_divergence> {
+  const auto binary = mapped_file{actual};
+  const auto text = mapped_file{reference};
+  return diff_traces(binary.bytes(), text.text(), context);
+}
+}; // namespace erelic
@@ -0,0 +1,112 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "address.hpp"
+
+namespace erelic {
+// State at the start of one instruction, as reference emulator logs print it: the address and opcode being executed,
+// the registers before it and the cycle count so far.
+struct trace_record {
+  address_raw pc = 0;
+  std::byte opcode{0x00};
+  std::byte a{0x00};
+  std::byte x{0x00};
+  std::byte y{0x00};
+  std::byte p{0x00};
+  std::byte s{0x00};
+  std::uint64_t cycle = 0;
+
+  auto operator==(const trace_record &o) const noexcept -> bool = default;
+};
+
+auto operator<<(std::ostream &os, const trace_record &r) -> std::ostream &;
+
+// Binary trace layout, integers are little-endian:
+//   "ERTR" | version:u8 | 11 zero bytes | { pc:u16 | opcode, a, x, y, p, s:u8 | cycle:u64 } * record count
+// Every record and the header are 16 bytes, so a mapped trace is an array of fixed records.
+constexpr auto trace_record_size = std::size_t{16};
+
+using encoded_trace_record = std::array<std::byte, trace_record_size>;
+
+[[nodiscard]] auto encode(const trace_record &r) noexcept -> encoded_trace_record;
+[[nodiscard]] auto decode(std::span<const std::byte, trace_record_size> bytes) noexcept -> trace_record;
+
+void write_trace_header(std::ostream &os);
+void write_trace_record(std::ostream &os, const trace_record &r);
+
+enum class trace_field : std::uint8_t {
+  PCNT,
+  OPCD,
+  REGA,
+  REGX,
+  REGY,
+  REGP,
+  REGS,
+  CYCL,
+};
+
+auto operator<<(std::ostream &os, const trace_field &f) -> std::ostream &;
+
+// One bit per `trace_field`.
+using trace_fields = std::uint8_t;
+
+constexpr auto field_bit(trace_field f) noexcept -> trace_fields {
+  return static_cast<trace_fields>(1U << static_cast<unsigned>(f));
+}
+
+struct parsed_trace_line {
+  trace_record record;
+  trace_fields fields = 0;
+};
+
+// Parses one line of a text trace in the nestest log layout: the PC as the first four hex digits, the opcode as the
+// hex byte after it, and `A:`, `X:`, `Y:`, `P:`, `SP:` (or `S:`) in hex and `CYC:` in decimal anywhere after that.
+// Returns the record with the fields found, or nothing for a line that does not start with a PC.
+[[nodiscard]] auto parse_trace_line(std::string_view line) noexcept -> std::optional<parsed_trace_line>;
+
+// Index of the first encoded record of `actual` that differs from `expected` in the bits set in `mask`, all three
+// holding the same number of records; their size if none does. Compares 64-bit words without branching per record.
+[[nodiscard]] auto first_mismatch(std::span<const std::byte> actual, std::span<const std::byte> expected,
+                                  std::span<const std::byte> mask) noexcept -> std::size_t;
+
+struct trace_divergence {
+  // Record number, counting from 0.
+  std::uint64_t index = 0;
+  // Line of the reference trace, counting from 1; 0 if the reference ended first.
+  std::uint64_t line = 0;
+  // Records of the binary trace before and after the diverging one, oldest first.
+  std::vector<trace_record> context{};
+  std::vector<trace_record> following{};
+  // Absent for the side that ended first.
+  std::optional<trace_record> actual{};
+  std::optional<trace_record> expected{};
+  // Fields the reference provides for the diverging record.
+  trace_fields fields = 0;
+};
+
+auto operator<<(std::ostream &os, const trace_divergence &d) -> std::ostream &;
+
+// Streams a binary trace against a text reference trace, parsing the reference in batches of fixed records, and stops
+// at the first divergence with up to `context` binary records on each side of it. Lines that do not parse are
+// skipped. Returns nothing if the traces agree. Throws `std::runtime_error` on a malformed binary trace.
+[[nodiscard]] auto diff_traces(std::span<const std::byte> actual, std::string_view reference, std::size_t context = 8)
+  -> std::optional<trace_divergence>;
+
+// Same as above over memory-mapped files, so traces larger than RAM work. Throws `std::system_error` if a file cannot
+// be mapped.
+[[nodiscard]] auto diff_trace_files(const std::filesystem::path &actual, const std::filesystem::path &reference,
+                                    std::size_t context = 8) -> std::optional<trace_divergence>;
+}; // namespace erelic
@@ -0,0 +1,113 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "address.hpp"
+#include "cycle_analyzer.hpp"
+#include "instruction.hpp"
+
+using namespace erelic;
+
+namespace {
+struct options {
+  std::string_view rom;
+  address origin{0x0000};
+  std::vector<address> entries{};
+  instruction_set set = instruction_set::NMOS;
+};
+
+// Hexadecimal, with an optional `$` or `0x` prefix.
+auto parse_address(std::string_view text) -> std::optional<address> {
+  if (text.starts_with('$')) {
+    text.remove_prefix(1);
+  } else if (text.starts_with("0x") || text.starts_with("0X")) {
+    text.remove_prefix(2);
+  }
+  auto raw = address_raw{0};
+  const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), raw, 16);
+  if (text.empty() || ec != std::errc{} || end != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return address{raw};
+}
+
+auto parse(std::span<char *> args) -> std::optional<options> {
+  auto opts = options{};
+  auto positional = std::size_t{0};
+  for (std::size_t i = 1; i < args.size(); ++i) {
+    const auto arg = std::string_view{args[i]};
+    if (arg == "--cmos") {
+      opts.set = instruction_set::CMOS;
+      continue;
+    }
+    if (positional == 0) {
+      opts.rom = arg;
+      ++positional;
+      continue;
+    }
+    const auto a = parse_address(arg);
+    if (!a) {
+      return std::nullopt;
+    }
+    if (positional == 1) {
+      opts.origin = *a;
+      ++positional;
+    } else {
+      opts.entries.push_back(*a);
+    }
+  }
+  if (opts.entries.empty()) {
+    return std::nullopt;
+  }
+  return opts;
+}
+
+auto read_file(std::string_view path) -> std::vector<std::byte> {
+  auto file = std::ifstream{std::string{path}, std::ios::binary};
+  if (!file) {
+    throw std::runtime_error("cannot open " + std::string{path});
+  }
+  auto bytes = std::vector<char>{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+  const auto data = std::as_bytes(std::span{bytes});
+  return {data.begin(), data.end()};
+}
+}; // namespace
+
+// Usage: erelic-cycle-analyzer [--cmos] ROM.bin ORIGIN ENTRY...
+//
+// Loads a ROM image at ORIGIN and prints the static cycle bounds of the routine at each entry point, addresses in
+// hexadecimal. Exits with 0 if every routine is bounded, 1 if one is not and 2 on errors.
+auto main(int argc, char **argv) -> int {
+  const auto opts = parse(std::span{argv, static_cast<std::size_t>(argc)});
+  if (!opts) {
+    std::cerr << "usage: erelic-cycle-analyzer [--cmos] ROM.bin ORIGIN ENTRY...\n";
+    return 2;
+  }
+
+  try {
+    const auto rom = read_file(opts->rom);
+    auto analyzer = cycle_analyzer{rom, opts->origin, opts->set};
+    auto bounded = true;
+    for (const auto &report : analyzer.analyze(opts->entries)) {
+      std::cout << report << "\n";
+      bounded = bounded && report.worst.has_value();
+    }
+    return bounded ? EXIT_SUCCESS : EXIT_FAILURE;
+  } catch (const std::exception &e) {
+    std::cerr << "erelic-cycle-analyzer: " << e.what() << "\n";
+    return 2;
+  }
+}
@@ -0,0 +1,77 @@
+//
+// Created by Kyrylo Rud on 19.10.2026.
+//
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string_view>
+
+#include "trace_diff.hpp"
+
+using namespace erelic;
+
+namespace {
+struct options {
+  std::string_view actual;
+  std::string_view reference;
+  std::size_t context = 8;
+};
+
+auto parse(std::span<char *> args) -> std::optional<options> {
+  auto opts = options{};
+  auto positional = std::size_t{0};
+  for (std::size_t i = 1; i < args.size(); ++i) {
+    const auto arg = std::string_view{args[i]};
+    if (arg == "--context" && i + 1 < args.size()) {
+      auto is = std::istringstream{args[++i]};
+      if (!(is >> opts.context)) {
+        return std::nullopt;
+      }
+    } else if (positional == 0) {
+      opts.actual = arg;
+      ++positional;
+    } else if (positional == 1) {
+      opts.reference = arg;
+      ++positional;
+    } else {
+      return std::nullopt;
+    }
+  }
+  if (positional != 2) {
+    return std::nullopt;
+  }
+  return opts;
+}
+}; // namespace
+
+// Usage: erelic-trace-diff [--context N] ACTUAL.bin REFERENCE.log
+//
+// Compares a binary trace written with `write_trace_record` against a reference emulator log and prints the first
+// divergence with up to N records of the binary trace before and after it, 8 by default. Exits with 0 if the traces
+// agree, 1 if they diverge and 2 on errors.
+auto main(int argc, char **argv) -> int {
+  const auto opts = parse(std::span{argv, static_cast<std::size_t>(argc)});
+  if (!opts) {
+    std::cerr << "usage: erelic-trace-diff [--context N] ACTUAL.bin REFERENCE.log\n"
+                 "  --context N  binary records shown before and after the divergence (default 8)\n";
+    return 2;
+  }
+
+  try {
+    const auto divergence = diff_trace_files(opts->actual, opts->reference, opts->context);
+    if (divergence) {
+      std::cout << *divergence << "\n";
+      return EXIT_FAILURE;
+    }
+    std::cout << "traces agree\n";
+    return EXIT_SUCCESS;
+  } catch (const std::exception &e) {
+    std::cerr << "erelic-trace-diff: " << e.what() << "\n";
+    return 2;
+  }
+}